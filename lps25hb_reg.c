@@ -34,6 +34,295 @@
   *
   */
 
+#define LPS25HB_I2C_AUTO_INC    0x80U
+#define LPS25HB_SPI_AUTO_INC    0x40U
+
+#ifndef LPS25HB_MEM_BARRIER
+#if defined(__GNUC__)
+#define LPS25HB_MEM_BARRIER()   __sync_synchronize()
+#else
+#define LPS25HB_MEM_BARRIER()
+#endif /* __GNUC__ */
+#endif /* LPS25HB_MEM_BARRIER */
+
+/*
+ * Set when the __sync builtins are expanded inline. Targets without
+ * exclusive access instructions (ARMv6-M) would call out-of-line
+ * __sync_* helpers that bare-metal libgcc does not provide, so they
+ * use the single core fallbacks.
+ */
+#ifndef LPS25HB_SYNC_BUILTINS
+#if defined(__GNUC__) && !defined(__ARM_ARCH_6M__) && \
+    defined(__GCC_ATOMIC_CHAR_LOCK_FREE) && \
+    (__GCC_ATOMIC_CHAR_LOCK_FREE == 2)
+#define LPS25HB_SYNC_BUILTINS   1
+#else
+#define LPS25HB_SYNC_BUILTINS   0
+#endif /* __GNUC__ */
+#endif /* LPS25HB_SYNC_BUILTINS */
+
+/**
+  * @brief  Add the auto-increment bit to the register address of a
+  *         multi-byte access, according to the bus type in priv_data.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register address
+  * @param  len   number of consecutive registers
+  * @retval       register address to send on the bus
+  *
+  */
+static uint8_t lps25hb_bus_address(const stmdev_ctx_t *ctx, uint8_t reg,
+                                   uint16_t len)
+{
+  const lps25hb_priv_t *priv;
+
+  if ((ctx->priv_data == NULL) || (len < 2U))
+  {
+    return reg;
+  }
+
+  priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  switch (priv->bus)
+  {
+    case LPS25HB_BUS_I2C:
+      reg |= LPS25HB_I2C_AUTO_INC;
+      break;
+
+    case LPS25HB_BUS_SPI:
+      reg |= LPS25HB_SPI_AUTO_INC;
+      break;
+
+    default:
+      break;
+  }
+
+  return reg;
+}
+
+/**
+  * @brief  Take the sensor lock, if provided in priv_data.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  *
+  */
+static void lps25hb_lock(const stmdev_ctx_t *ctx)
+{
+  const lps25hb_priv_t *priv;
+
+  if (ctx == NULL)
+  {
+    return;
+  }
+
+  priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  if ((priv != NULL) && (priv->lock != NULL))
+  {
+    priv->lock(priv->lock_arg);
+  }
+}
+
+/**
+  * @brief  Release the sensor lock, if provided in priv_data.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  *
+  */
+static void lps25hb_unlock(const stmdev_ctx_t *ctx)
+{
+  const lps25hb_priv_t *priv;
+
+  if (ctx == NULL)
+  {
+    return;
+  }
+
+  priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  if ((priv != NULL) && (priv->unlock != NULL))
+  {
+    priv->unlock(priv->lock_arg);
+  }
+}
+
+#ifdef LPS25HB_INSTRUMENTATION
+
+/* Attempts of a statistics copy before giving up */
+#define LPS25HB_STATS_RETRY     64U
+
+/*
+ * Atomic add on a statistics counter. Other compilers must define it
+ * when the driver is used from more than one core.
+ */
+#ifndef LPS25HB_STATS_ADD
+#if defined(__GNUC__)
+#define LPS25HB_STATS_ADD(ptr, val) (void)__sync_fetch_and_add((ptr), (val))
+#else
+#define LPS25HB_STATS_ADD(ptr, val) (*(ptr) += (val))
+#endif /* __GNUC__ */
+#endif /* LPS25HB_STATS_ADD */
+
+/**
+  * @brief  Get the current tick from the time base in priv_data.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       current tick, 0 if no time base is available
+  *
+  */
+static uint32_t lps25hb_stats_tick(const stmdev_ctx_t *ctx)
+{
+  const lps25hb_priv_t *priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  if ((priv == NULL) || (priv->get_tick == NULL))
+  {
+    return 0;
+  }
+
+  return priv->get_tick();
+}
+
+/**
+  * @brief  Account a register access in the statistics of priv_data.
+  *
+  * @param  ctx     read / write interface definitions(ptr)
+  * @param  reg     register accessed
+  * @param  len     number of consecutive registers
+  * @param  write   1 for a write access, 0 for a read access
+  * @param  err     interface status of the access
+  * @param  start   tick at the start of the access
+  *
+  */
+static void lps25hb_stats_record(const stmdev_ctx_t *ctx, uint8_t reg,
+                                 uint16_t len, uint8_t write, int32_t err,
+                                 uint32_t start)
+{
+  lps25hb_priv_t *priv = (lps25hb_priv_t *)ctx->priv_data;
+  lps25hb_reg_stats_t *stats;
+  uint32_t elapsed;
+  uint8_t bucket = 0;
+
+  if ((priv == NULL) || (reg >= LPS25HB_STATS_REG_NUM))
+  {
+    return;
+  }
+
+  /* writers never wait: counters are updated with atomic adds */
+  LPS25HB_STATS_ADD(&priv->stats.begin, 1U);
+  LPS25HB_MEM_BARRIER();
+  stats = &priv->stats.reg[reg];
+
+  if (write != 0U)
+  {
+    LPS25HB_STATS_ADD(&stats->write_cnt, 1U);
+  }
+  else
+  {
+    LPS25HB_STATS_ADD(&stats->read_cnt, 1U);
+  }
+
+  if (err != 0)
+  {
+    LPS25HB_STATS_ADD(&stats->err_cnt, 1U);
+    stats->last_err = err;
+  }
+  else
+  {
+    LPS25HB_STATS_ADD(&stats->bytes, (uint32_t)len);
+  }
+
+  if (priv->get_tick != NULL)
+  {
+    elapsed = (priv->get_tick() - start) >> 1;
+
+    while ((elapsed != 0U) && (bucket < (LPS25HB_STATS_BUCKETS - 1U)))
+    {
+      elapsed >>= 1;
+      bucket++;
+    }
+
+    LPS25HB_STATS_ADD(&stats->latency[bucket], 1U);
+  }
+
+  LPS25HB_MEM_BARRIER();
+  LPS25HB_STATS_ADD(&priv->stats.end, 1U);
+}
+
+/**
+  * @brief  Account a multi-segment transaction, one access per segment.
+  *         Each segment is given the latency of the whole transaction.
+  *
+  * @param  ctx     read / write interface definitions(ptr)
+  * @param  seg     list of register segments(ptr)
+  * @param  num     number of segments
+  * @param  write   1 for a write access, 0 for a read access
+  * @param  err     interface status of the transaction
+  * @param  start   tick at the start of the transaction
+  *
+  */
+static void lps25hb_stats_record_seg(const stmdev_ctx_t *ctx,
+                                     const lps25hb_seg_t *seg, uint16_t num,
+                                     uint8_t write, int32_t err,
+                                     uint32_t start)
+{
+  uint16_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    lps25hb_stats_record(ctx, seg[i].reg, seg[i].len, write, err, start);
+  }
+}
+
+/**
+  * @brief  Get a consistent copy of the statistics of a register without
+  *         blocking the read / write functions: the copy is retried if
+  *         an access was accounted meanwhile, LPS25HB_STATS_RETRY times
+  *         at most.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register address
+  * @param  val   copy of the register statistics(ptr)
+  * @retval       0 -> no Error, -1 on invalid argument or if no
+  *               consistent copy could be taken
+  *
+  */
+int32_t lps25hb_stats_get(const stmdev_ctx_t *ctx, uint8_t reg,
+                          lps25hb_reg_stats_t *val)
+{
+  const lps25hb_priv_t *priv;
+  uint32_t begin;
+  uint32_t end;
+  uint8_t i;
+
+  if ((ctx == NULL) || (ctx->priv_data == NULL) ||
+      (reg >= LPS25HB_STATS_REG_NUM))
+  {
+    return -1;
+  }
+
+  priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  for (i = 0; i < LPS25HB_STATS_RETRY; i++)
+  {
+    /* end is read first: begin == end means no update in progress */
+    end = priv->stats.end;
+    LPS25HB_MEM_BARRIER();
+    begin = priv->stats.begin;
+    LPS25HB_MEM_BARRIER();
+    *val = priv->stats.reg[reg];
+    LPS25HB_MEM_BARRIER();
+
+    if ((begin == end) && (begin == priv->stats.begin))
+    {
+      return 0;
+    }
+  }
+
+  return -1;
+}
+
+#endif /* LPS25HB_INSTRUMENTATION */
+
 /**
   * @brief  Read generic device register
   *
@@ -49,13 +338,25 @@ int32_t __weak lps25hb_read_reg(const stmdev_ctx_t *ctx, uint8_t reg,
                                 uint16_t len)
 {
   int32_t ret;
+#ifdef LPS25HB_INSTRUMENTATION
+  uint32_t start;
+#endif /* LPS25HB_INSTRUMENTATION */
 
   if (ctx == NULL)
   {
     return -1;
   }
 
-  ret = ctx->read_reg(ctx->handle, reg, data, len);
+#ifdef LPS25HB_INSTRUMENTATION
+  start = lps25hb_stats_tick(ctx);
+#endif /* LPS25HB_INSTRUMENTATION */
+
+  ret = ctx->read_reg(ctx->handle, lps25hb_bus_address(ctx, reg, len),
+                      data, len);
+
+#ifdef LPS25HB_INSTRUMENTATION
+  lps25hb_stats_record(ctx, reg, len, 0, ret, start);
+#endif /* LPS25HB_INSTRUMENTATION */
 
   return ret;
 }
@@ -75,13 +376,25 @@ int32_t __weak lps25hb_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
                                  uint16_t len)
 {
   int32_t ret;
+#ifdef LPS25HB_INSTRUMENTATION
+  uint32_t start;
+#endif /* LPS25HB_INSTRUMENTATION */
 
   if (ctx == NULL)
   {
     return -1;
   }
 
-  ret = ctx->write_reg(ctx->handle, reg, data, len);
+#ifdef LPS25HB_INSTRUMENTATION
+  start = lps25hb_stats_tick(ctx);
+#endif /* LPS25HB_INSTRUMENTATION */
+
+  ret = ctx->write_reg(ctx->handle, lps25hb_bus_address(ctx, reg, len),
+                       data, len);
+
+#ifdef LPS25HB_INSTRUMENTATION
+  lps25hb_stats_record(ctx, reg, len, 1, ret, start);
+#endif /* LPS25HB_INSTRUMENTATION */
 
   return ret;
 }
@@ -92,147 +405,2221 @@ int32_t __weak lps25hb_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
   */
 
 /**
-  * @defgroup    LPS25HB_Sensitivity
-  * @brief       These functions convert raw-data into engineering units.
+  * @defgroup    LPS25HB_Shadow
+  * @brief       This section provide the register shadow used by the
+  *              configuration functions when priv_data is set.
   * @{
   *
   */
 
-float_t lps25hb_from_lsb_to_hpa(uint32_t lsb)
+#define LPS25HB_SHADOW_BIT(reg) \
+  ((uint64_t)1U << ((uint8_t)(reg) - LPS25HB_SHADOW_FIRST))
+
+#define LPS25HB_SHADOW_MASK \
+  (LPS25HB_SHADOW_BIT(LPS25HB_REF_P_XL) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_REF_P_L) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_REF_P_H) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_RES_CONF) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG1) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG2) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG3) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG4) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_INTERRUPT_CFG) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_FIFO_CTRL) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_THS_P_L) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_THS_P_H) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_RPDS_L) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_RPDS_H))
+
+#define LPS25HB_SHADOW_REF_P \
+  (LPS25HB_SHADOW_BIT(LPS25HB_REF_P_XL) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_REF_P_L) | \
+   LPS25HB_SHADOW_BIT(LPS25HB_REF_P_H))
+
+/**
+  * @brief  Get the register shadow linked to the context, if any.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       pointer to the shadow or NULL when not enabled
+  *
+  */
+static lps25hb_shadow_t *lps25hb_shadow_ptr(const stmdev_ctx_t *ctx)
 {
-  return ((float_t)lsb / 4096.0f);
+  lps25hb_priv_t *priv;
+
+  if ((ctx == NULL) || (ctx->priv_data == NULL))
+  {
+    return NULL;
+  }
+
+  priv = (lps25hb_priv_t *)ctx->priv_data;
+
+  return (priv->shadow_en != 0U) ? &priv->shadow : NULL;
 }
 
-float_t lps25hb_from_lsb_to_degc(int16_t lsb)
+/**
+  * @brief  Check if the address is a shadowed register.
+  *
+  * @param  reg   register address
+  * @retval       1 if shadowed, 0 otherwise
+  *
+  */
+static uint8_t lps25hb_shadow_has(uint16_t reg)
 {
-  return ((float_t)lsb / 480.0f) + 42.5f ;
+  if ((reg < LPS25HB_SHADOW_FIRST) || (reg > LPS25HB_SHADOW_LAST))
+  {
+    return 0;
+  }
+
+  return ((LPS25HB_SHADOW_MASK & LPS25HB_SHADOW_BIT(reg)) != 0U) ? 1U : 0U;
 }
 
 /**
-  * @}
+  * @brief  Drop from the shadow the bytes that the device may have
+  *         changed on its own after the write of CTRL_REG1 / CTRL_REG2.
+  *         One-shot self-clears, autozero updates REF_P, while software
+  *         reset and boot restore the whole register map.
+  *
+  * @param  shadow   register shadow(ptr)
   *
   */
+static void lps25hb_shadow_fixup(lps25hb_shadow_t *shadow)
+{
+  lps25hb_ctrl_reg1_t ctrl_reg1;
+  lps25hb_ctrl_reg2_t ctrl_reg2;
+  uint8_t idx;
+
+  idx = LPS25HB_CTRL_REG1 - LPS25HB_SHADOW_FIRST;
+
+  if ((shadow->valid & LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG1)) != 0U)
+  {
+    *(uint8_t *)&ctrl_reg1 = shadow->reg[idx];
+
+    if (ctrl_reg1.reset_az != 0U)
+    {
+      shadow->valid &= ~(LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG1) |
+                         LPS25HB_SHADOW_REF_P);
+    }
+  }
+
+  idx = LPS25HB_CTRL_REG2 - LPS25HB_SHADOW_FIRST;
+
+  if ((shadow->valid & LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG2)) != 0U)
+  {
+    *(uint8_t *)&ctrl_reg2 = shadow->reg[idx];
+
+    if ((ctrl_reg2.swreset != 0U) || (ctrl_reg2.boot != 0U))
+    {
+      shadow->valid = 0;
+    }
+    else if (ctrl_reg2.autozero != 0U)
+    {
+      shadow->valid &= ~(LPS25HB_SHADOW_BIT(LPS25HB_CTRL_REG2) |
+                         LPS25HB_SHADOW_REF_P);
+    }
+    else
+    {
+      ctrl_reg2.one_shot = PROPERTY_DISABLE;
+      shadow->reg[idx] = *(uint8_t *)&ctrl_reg2;
+    }
+  }
+}
 
 /**
-  * @defgroup   LPS25HB_data_generation_c
-  * @brief      This section group all the functions concerning data generation
-  * @{
+  * @brief  Copy the shadowed bytes of a register range into the shadow.
+  *
+  * @param  shadow   register shadow(ptr)
+  * @param  reg      first register of the range
+  * @param  data     register content(ptr)
+  * @param  len      number of consecutive registers
   *
   */
+static void lps25hb_shadow_store(lps25hb_shadow_t *shadow, uint8_t reg,
+                                 const uint8_t *data, uint16_t len)
+{
+  uint16_t addr;
+  uint16_t i;
+
+  for (i = 0; i < len; i++)
+  {
+    addr = (uint16_t)reg + i;
+
+    if (lps25hb_shadow_has(addr) != 0U)
+    {
+      shadow->reg[addr - LPS25HB_SHADOW_FIRST] = data[i];
+      shadow->valid |= LPS25HB_SHADOW_BIT(addr);
+    }
+  }
+
+  lps25hb_shadow_fixup(shadow);
+}
 
 /**
-  * @brief  The Reference pressure value is a 24-bit data expressed as 2’s
-  *         complement. The value is used when AUTOZERO or AUTORIFP function
-  *         is enabled.[set]
+  * @brief  Remove a register range from the shadow.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that contains data to write
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  shadow   register shadow(ptr)
+  * @param  reg      first register of the range
+  * @param  len      number of consecutive registers
   *
   */
-int32_t lps25hb_pressure_ref_set(const stmdev_ctx_t *ctx, int32_t val)
+static void lps25hb_shadow_drop(lps25hb_shadow_t *shadow, uint8_t reg,
+                                uint16_t len)
 {
-  uint8_t buff[3];
+  uint16_t addr;
+  uint16_t i;
+
+  for (i = 0; i < len; i++)
+  {
+    addr = (uint16_t)reg + i;
+
+    if (lps25hb_shadow_has(addr) != 0U)
+    {
+      shadow->valid &= ~LPS25HB_SHADOW_BIT(addr);
+    }
+  }
+}
+
+/**
+  * @brief  Read configuration registers, from the shadow when all the
+  *         requested bytes are known, from the device otherwise.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register to read
+  * @param  data  pointer to buffer that store the data read(ptr)
+  * @param  len   number of consecutive register to read
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lps25hb_shadow_read_reg(const stmdev_ctx_t *ctx, uint8_t reg,
+                                       uint8_t *data, uint16_t len)
+{
+  lps25hb_shadow_t *shadow;
+  uint16_t addr;
+  uint16_t i;
   int32_t ret;
 
-  buff[2] = (uint8_t)((uint32_t)val / 65536U);
-  buff[1] = (uint8_t)((uint32_t)val - (buff[2] * 65536U)) / 256U;
-  buff[0] = (uint8_t)((uint32_t)val - (buff[2] * 65536U) -
-                      (buff[1] * 256U));
-  ret = lps25hb_read_reg(ctx, LPS25HB_REF_P_XL,  buff, 3);
+  shadow = lps25hb_shadow_ptr(ctx);
+
+  if (shadow != NULL)
+  {
+    for (i = 0; i < len; i++)
+    {
+      addr = (uint16_t)reg + i;
+
+      if ((lps25hb_shadow_has(addr) == 0U) ||
+          ((shadow->valid & LPS25HB_SHADOW_BIT(addr)) == 0U))
+      {
+        break;
+      }
+    }
+
+    if (i == len)
+    {
+      for (i = 0; i < len; i++)
+      {
+        data[i] = shadow->reg[(uint16_t)reg + i - LPS25HB_SHADOW_FIRST];
+      }
+
+      return 0;
+    }
+  }
+
+  ret = lps25hb_read_reg(ctx, reg, data, len);
+
+  if ((ret == 0) && (shadow != NULL))
+  {
+    lps25hb_shadow_store(shadow, reg, data, len);
+  }
 
   return ret;
 }
 
 /**
-  * @brief  The Reference pressure value is a 24-bit data expressed as 2’s
-  *         complement. The value is used when AUTOZERO or AUTORIFP function
-  *         is enabled.[get]
+  * @brief  Write configuration registers and keep the shadow aligned.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that stores data read.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   register to write
+  * @param  data  pointer to data to write in register reg(ptr)
+  * @param  len   number of consecutive register to write
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lps25hb_pressure_ref_get(const stmdev_ctx_t *ctx, int32_t *val)
+static int32_t lps25hb_shadow_write_reg(const stmdev_ctx_t *ctx,
+                                        uint8_t reg, uint8_t *data,
+                                        uint16_t len)
 {
-  uint8_t buff[3];
+  lps25hb_shadow_t *shadow;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_REF_P_XL,  buff, 3);
+  ret = lps25hb_write_reg(ctx, reg, data, len);
 
-  if (ret != 0) { return ret; }
+  shadow = lps25hb_shadow_ptr(ctx);
 
-  *val = (int32_t)buff[2];
-  *val = (*val * 256) + (int32_t)buff[1];
-  *val = (*val * 256) + (int32_t)buff[0];
+  if (shadow != NULL)
+  {
+    if (ret == 0)
+    {
+      lps25hb_shadow_store(shadow, reg, data, len);
+    }
+    else
+    {
+      lps25hb_shadow_drop(shadow, reg, len);
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Discard the register shadow content. Must be called when the
+  *         device registers are changed outside the driver (e.g. after
+  *         a power cycle of the sensor).
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps25hb_shadow_invalidate(const stmdev_ctx_t *ctx)
+{
+  lps25hb_shadow_t *shadow;
+
+  if (ctx == NULL)
+  {
+    return -1;
+  }
+
+  shadow = lps25hb_shadow_ptr(ctx);
+
+  if (shadow != NULL)
+  {
+    lps25hb_lock(ctx);
+    shadow->valid = 0;
+    lps25hb_unlock(ctx);
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup    LPS25HB_Multi_Segment
+  * @brief       This section provide the functions used to access several
+  *              register ranges in a single bus transaction.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Set or clear the auto-increment bit on all the segments.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  seg   list of register segments(ptr)
+  * @param  num   number of segments
+  * @param  set   1 to set the bus address, 0 to restore the register one
+  *
+  */
+static void lps25hb_seg_address(const stmdev_ctx_t *ctx, lps25hb_seg_t *seg,
+                                uint16_t num, uint8_t set)
+{
+  uint16_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    if (set != 0U)
+    {
+      seg[i].reg = lps25hb_bus_address(ctx, seg[i].reg, seg[i].len);
+    }
+    else
+    {
+      seg[i].reg &= (uint8_t)~(LPS25HB_I2C_AUTO_INC | LPS25HB_SPI_AUTO_INC);
+    }
+  }
+}
+
+/**
+  * @brief  Read a list of register segments. If read_multi is provided in
+  *         priv_data all the segments are read in one bus transaction,
+  *         otherwise they are read one after the other.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  seg   list of register segments(ptr)
+  * @param  num   number of segments
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps25hb_read_multi_reg(const stmdev_ctx_t *ctx, lps25hb_seg_t *seg,
+                               uint16_t num)
+{
+  const lps25hb_priv_t *priv;
+  uint16_t i;
+  int32_t ret = 0;
+#ifdef LPS25HB_INSTRUMENTATION
+  uint32_t start;
+#endif /* LPS25HB_INSTRUMENTATION */
+
+  if (ctx == NULL)
+  {
+    return -1;
+  }
+
+  priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  lps25hb_lock(ctx);
+
+  if ((priv != NULL) && (priv->read_multi != NULL))
+  {
+#ifdef LPS25HB_INSTRUMENTATION
+    start = lps25hb_stats_tick(ctx);
+#endif /* LPS25HB_INSTRUMENTATION */
+    lps25hb_seg_address(ctx, seg, num, 1);
+    ret = priv->read_multi(ctx->handle, seg, num);
+    lps25hb_seg_address(ctx, seg, num, 0);
+#ifdef LPS25HB_INSTRUMENTATION
+    lps25hb_stats_record_seg(ctx, seg, num, 0, ret, start);
+#endif /* LPS25HB_INSTRUMENTATION */
+  }
+  else
+  {
+    for (i = 0; (i < num) && (ret == 0); i++)
+    {
+      ret = lps25hb_read_reg(ctx, seg[i].reg, seg[i].data, seg[i].len);
+    }
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Write a list of register segments. If write_multi is provided
+  *         in priv_data all the segments are written in one bus
+  *         transaction, otherwise they are written one after the other.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  seg   list of register segments(ptr)
+  * @param  num   number of segments
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lps25hb_write_multi_reg(const stmdev_ctx_t *ctx, lps25hb_seg_t *seg,
+                                uint16_t num)
+{
+  const lps25hb_priv_t *priv;
+  lps25hb_shadow_t *shadow;
+  uint16_t i;
+  int32_t ret = 0;
+#ifdef LPS25HB_INSTRUMENTATION
+  uint32_t start;
+#endif /* LPS25HB_INSTRUMENTATION */
+
+  if (ctx == NULL)
+  {
+    return -1;
+  }
+
+  priv = (const lps25hb_priv_t *)ctx->priv_data;
+
+  lps25hb_lock(ctx);
+
+  if ((priv == NULL) || (priv->write_multi == NULL))
+  {
+    for (i = 0; (i < num) && (ret == 0); i++)
+    {
+      ret = lps25hb_shadow_write_reg(ctx, seg[i].reg, seg[i].data,
+                                     seg[i].len);
+    }
+  }
+  else
+  {
+#ifdef LPS25HB_INSTRUMENTATION
+    start = lps25hb_stats_tick(ctx);
+#endif /* LPS25HB_INSTRUMENTATION */
+    lps25hb_seg_address(ctx, seg, num, 1);
+    ret = priv->write_multi(ctx->handle, seg, num);
+    lps25hb_seg_address(ctx, seg, num, 0);
+#ifdef LPS25HB_INSTRUMENTATION
+    lps25hb_stats_record_seg(ctx, seg, num, 1, ret, start);
+#endif /* LPS25HB_INSTRUMENTATION */
+
+    shadow = lps25hb_shadow_ptr(ctx);
+
+    for (i = 0; (i < num) && (shadow != NULL); i++)
+    {
+      if (ret == 0)
+      {
+        lps25hb_shadow_store(shadow, seg[i].reg, seg[i].data, seg[i].len);
+      }
+      else
+      {
+        lps25hb_shadow_drop(shadow, seg[i].reg, seg[i].len);
+      }
+    }
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup    LPS25HB_Sensitivity
+  * @brief       These functions convert raw-data into engineering units.
+  * @{
+  *
+  */
+
+float_t lps25hb_from_lsb_to_hpa(uint32_t lsb)
+{
+  return ((float_t)lsb / 4096.0f);
+}
+
+float_t lps25hb_from_lsb_to_degc(int16_t lsb)
+{
+  return ((float_t)lsb / 480.0f) + 42.5f ;
+}
+
+/**
+  * @brief  Convert an array of raw pressure values, same result as
+  *         lps25hb_from_lsb_to_hpa. The loop has no dependency between
+  *         iterations, so that the compiler can vectorize it.
+  *
+  * @param  lsb    Raw pressure values.(ptr)
+  * @param  hpa    Pressure values [hPa], must not overlap lsb.(ptr)
+  * @param  num    Number of values
+  *
+  */
+void lps25hb_from_lsb_to_hpa_batch(const uint32_t *lsb, float_t *hpa,
+                                   uint32_t num)
+{
+  uint32_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    hpa[i] = (float_t)lsb[i] / 4096.0f;
+  }
+}
+
+/**
+  * @brief  Convert an array of raw temperature values, same result as
+  *         lps25hb_from_lsb_to_degc. The loop has no dependency between
+  *         iterations, so that the compiler can vectorize it.
+  *
+  * @param  lsb    Raw temperature values.(ptr)
+  * @param  degc   Temperature values [degC], must not overlap lsb.(ptr)
+  * @param  num    Number of values
+  *
+  */
+void lps25hb_from_lsb_to_degc_batch(const int16_t *lsb, float_t *degc,
+                                    uint32_t num)
+{
+  uint32_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    degc[i] = ((float_t)lsb[i] / 480.0f) + 42.5f;
+  }
+}
+
+/**
+  * @brief  Convert samples straight from the registers content, as read
+  *         by lps25hb_fifo_raw_get, in a single pass. Same result as
+  *         lps25hb_from_lsb_to_hpa and lps25hb_from_lsb_to_degc applied
+  *         to the raw values.
+  *
+  * @param  raw    Registers content, LPS25HB_SAMPLE_LEN bytes per
+  *                sample.(ptr)
+  * @param  hpa    Pressure values [hPa].(ptr)
+  * @param  degc   Temperature values [degC].(ptr)
+  * @param  num    Number of samples
+  *
+  */
+void lps25hb_from_raw_to_units(const uint8_t *raw, float_t *hpa,
+                               float_t *degc, uint32_t num)
+{
+  const uint8_t *buff;
+  uint32_t pressure;
+  int16_t temperature;
+  uint32_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    buff = &raw[i * LPS25HB_SAMPLE_LEN];
+    pressure = ((uint32_t)buff[2] << 24) | ((uint32_t)buff[1] << 16) |
+               ((uint32_t)buff[0] << 8);
+    temperature = (int16_t)(((uint16_t)buff[4] << 8) | (uint16_t)buff[3]);
+    hpa[i] = (float_t)pressure / 4096.0f;
+    degc[i] = ((float_t)temperature / 480.0f) + 42.5f;
+  }
+}
+
+/**
+  * @brief  Integer equivalent of lps25hb_from_lsb_to_hpa, for targets
+  *         without FPU: no float and no division is used.
+  *         The result is the exact value rounded to nearest (half up),
+  *         so it is within 0.5 Pa of the exact value and of 100 times
+  *         the lps25hb_from_lsb_to_hpa result (plus its float rounding,
+  *         below 0.01 Pa in the sensor range).
+  *
+  * @param  lsb    Raw pressure, as lps25hb_pressure_raw_get
+  * @retval        Pressure [Pa] (hPa x 100)
+  *
+  */
+uint32_t lps25hb_from_lsb_to_pa(uint32_t lsb)
+{
+  /* lsb * 100 / 4096 = lsb * 25 / 1024, split to stay in 32 bit */
+  return ((lsb >> 10) * 25U) + ((((lsb & 0x3FFU) * 25U) + 512U) >> 10);
+}
+
+/**
+  * @brief  Integer equivalent of lps25hb_from_lsb_to_degc, for targets
+  *         without FPU: no float and no division is used.
+  *         The result is the exact value rounded to nearest (half up),
+  *         so it is within 0.5 centidegree of the exact value and of
+  *         100 times the lps25hb_from_lsb_to_degc result (plus its
+  *         float rounding, below 0.001 centidegree).
+  *
+  * @param  lsb    Raw temperature, as lps25hb_temperature_raw_get
+  * @retval        Temperature [degC x 100]
+  *
+  */
+int16_t lps25hb_from_lsb_to_cdegc(int16_t lsb)
+{
+  uint32_t val;
+
+  /*
+   * lsb * 100 / 480 + 4250 = (lsb * 5 + 102000) / 24, made positive
+   * with an offset of 2600 * 24 and rounded: val < 2^19 in all cases.
+   * val / 24 = (val / 8) / 3 and x / 3 = (x * 43691) >> 17 for x < 2^16.
+   */
+  val = ((uint32_t)((int32_t)lsb + 32768) * 5U) + 560U + 12U;
+  val = ((val >> 3) * 43691U) >> 17;
+
+  return (int16_t)((int32_t)val - 2600);
+}
+
+/**
+  * @brief  Convert an array of raw pressure values, same result as
+  *         lps25hb_from_lsb_to_pa.
+  *
+  * @param  lsb    Raw pressure values.(ptr)
+  * @param  pa     Pressure values [Pa], must not overlap lsb.(ptr)
+  * @param  num    Number of values
+  *
+  */
+void lps25hb_from_lsb_to_pa_batch(const uint32_t *lsb, uint32_t *pa,
+                                  uint32_t num)
+{
+  uint32_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    pa[i] = lps25hb_from_lsb_to_pa(lsb[i]);
+  }
+}
+
+/**
+  * @brief  Convert an array of raw temperature values, same result as
+  *         lps25hb_from_lsb_to_cdegc.
+  *
+  * @param  lsb    Raw temperature values.(ptr)
+  * @param  cdegc  Temperature values [degC x 100], must not overlap
+  *                lsb.(ptr)
+  * @param  num    Number of values
+  *
+  */
+void lps25hb_from_lsb_to_cdegc_batch(const int16_t *lsb, int16_t *cdegc,
+                                     uint32_t num)
+{
+  uint32_t i;
+
+  for (i = 0; i < num; i++)
+  {
+    cdegc[i] = lps25hb_from_lsb_to_cdegc(lsb[i]);
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup   LPS25HB_data_generation_c
+  * @brief      This section group all the functions concerning data generation
+  * @{
+  *
+  */
+
+/**
+  * @brief  The Reference pressure value is a 24-bit data expressed as 2’s
+  *         complement. The value is used when AUTOZERO or AUTORIFP function
+  *         is enabled.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that contains data to write
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_ref_set(const stmdev_ctx_t *ctx, int32_t val)
+{
+  uint32_t u = (uint32_t)val;
+  uint8_t buff[3];
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  buff[0] = (uint8_t)(u & 0xFFU);
+  buff[1] = (uint8_t)((u >> 8) & 0xFFU);
+  buff[2] = (uint8_t)((u >> 16) & 0xFFU);
+  ret = lps25hb_shadow_write_reg(ctx, LPS25HB_REF_P_XL,  buff, 3);
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  The Reference pressure value is a 24-bit data expressed as 2’s
+  *         complement. The value is used when AUTOZERO or AUTORIFP function
+  *         is enabled.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that stores data read.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_ref_get(const stmdev_ctx_t *ctx, int32_t *val)
+{
+  uint8_t buff[3];
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_REF_P_XL,  buff, 3);
+
+  if (ret != 0) { return ret; }
+
+  *val = (int32_t)buff[2];
+  *val = (*val * 256) + (int32_t)buff[1];
+  *val = (*val * 256) + (int32_t)buff[0];
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure internal average configuration.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of avgp in reg RES_CONF
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_avg_set(const stmdev_ctx_t *ctx,
+                                 lps25hb_avgp_t val)
+{
+  lps25hb_res_conf_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.avgp = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure internal average configuration.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of avgp in reg RES_CONF.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_avg_get(const stmdev_ctx_t *ctx,
+                                 lps25hb_avgp_t *val)
+{
+  lps25hb_res_conf_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.avgp)
+  {
+    case LPS25HB_P_AVG_8:
+      *val = LPS25HB_P_AVG_8;
+      break;
+
+    case LPS25HB_P_AVG_16:
+      *val = LPS25HB_P_AVG_16;
+      break;
+
+    case LPS25HB_P_AVG_32:
+      *val = LPS25HB_P_AVG_32;
+      break;
+
+    case LPS25HB_P_AVG_64:
+      *val = LPS25HB_P_AVG_64;
+      break;
+
+    default:
+      *val = LPS25HB_P_AVG_8;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Temperature internal average configuration.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of avgt in reg RES_CONF
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_temperature_avg_set(const stmdev_ctx_t *ctx,
+                                    lps25hb_avgt_t val)
+{
+  lps25hb_res_conf_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.avgt = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Temperature internal average configuration.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of avgt in reg RES_CONF.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_temperature_avg_get(const stmdev_ctx_t *ctx,
+                                    lps25hb_avgt_t *val)
+{
+  lps25hb_res_conf_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.avgt)
+  {
+    case LPS25HB_T_AVG_8:
+      *val = LPS25HB_T_AVG_8;
+      break;
+
+    case LPS25HB_T_AVG_16:
+      *val = LPS25HB_T_AVG_16;
+      break;
+
+    case LPS25HB_T_AVG_32:
+      *val = LPS25HB_T_AVG_32;
+      break;
+
+    case LPS25HB_T_AVG_64:
+      *val = LPS25HB_T_AVG_64;
+      break;
+
+    default:
+      *val = LPS25HB_T_AVG_8;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Reset Autozero function. [set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of reset_az in reg CTRL_REG1
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_autozero_rst_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.reset_az = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Reset Autozero function.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of reset_az in reg CTRL_REG1.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_autozero_rst_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.reset_az;
+
+  return ret;
+}
+
+/**
+  * @brief  Blockdataupdate.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of bdu in reg CTRL_REG1
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.bdu = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief Blockdataupdate. [get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of bdu in reg CTRL_REG1.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.bdu;
+
+  return ret;
+}
+
+/**
+  * @brief  Output data rate selection.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of odr in reg CTRL_REG1
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_data_rate_set(const stmdev_ctx_t *ctx, lps25hb_odr_t val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.odr = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Output data rate selection.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of odr in reg CTRL_REG1.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_data_rate_get(const stmdev_ctx_t *ctx, lps25hb_odr_t *val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.odr)
+  {
+    case LPS25HB_POWER_DOWN:
+      *val = LPS25HB_POWER_DOWN;
+      break;
+
+    case LPS25HB_ODR_1Hz:
+      *val = LPS25HB_ODR_1Hz;
+      break;
+
+    case LPS25HB_ODR_7Hz:
+      *val = LPS25HB_ODR_7Hz;
+      break;
+
+    case LPS25HB_ODR_12Hz5:
+      *val = LPS25HB_ODR_12Hz5;
+      break;
+
+    case LPS25HB_ODR_25Hz:
+      *val = LPS25HB_ODR_25Hz;
+      break;
+
+    case LPS25HB_ONE_SHOT:
+      *val = LPS25HB_ONE_SHOT;
+      break;
+
+    default:
+      *val = LPS25HB_POWER_DOWN;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  One-shot mode. Device perform a single measure.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of one_shot in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_one_shoot_trigger_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.one_shot = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  One-shot mode. Device perform a single measure.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of one_shot in reg CTRL_REG2.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_one_shoot_trigger_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.one_shot;
+
+  return ret;
+}
+
+/**
+  * @brief  Enable Autozero function.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of autozero in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_autozero_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.autozero = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Enable Autozero function.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of autozero in reg CTRL_REG2.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_autozero_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.autozero;
+
+  return ret;
+}
+
+/**
+  * @brief  Enable to decimate the output pressure to 1Hz
+  *         with FIFO Mean mode.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of fifo_mean_dec in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_mean_decimator_set(const stmdev_ctx_t *ctx,
+                                        uint8_t val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.fifo_mean_dec = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Enable to decimate the output pressure to 1Hz
+  *         with FIFO Mean mode.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of fifo_mean_dec in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_mean_decimator_get(const stmdev_ctx_t *ctx,
+                                        uint8_t *val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.fifo_mean_dec;
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure data available.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of p_da in reg STATUS_REG.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_press_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_status_reg_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.p_da;
+
+  return ret;
+}
+
+/**
+  * @brief  Temperature data available.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of t_da in reg STATUS_REG.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_temp_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_status_reg_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.t_da;
+
+  return ret;
+}
+
+/**
+  * @brief  Temperature data overrun.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of t_or in reg STATUS_REG.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_temp_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_status_reg_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.t_or;
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure data overrun.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of p_or in reg STATUS_REG.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_press_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_status_reg_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.p_or;
+
+  return ret;
+}
+
+/**
+  * @brief  Pressure output value.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that stores data read.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_raw_get(const stmdev_ctx_t *ctx, uint32_t *buff)
+{
+  uint8_t reg[3];
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_PRESS_OUT_XL,  reg, 3);
+
+  if (ret != 0) { return ret; }
+
+  *buff = reg[2];
+  *buff = (*buff * 256) + reg[1];
+  *buff = (*buff * 256) + reg[0];
+  *buff *= 256;
+
+  return ret;
+}
+
+/**
+  * @brief  Temperature output value.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that stores data read.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_temperature_raw_get(const stmdev_ctx_t *ctx, int16_t *buff)
+{
+  uint8_t reg[2];
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_TEMP_OUT_L,  reg, 2);
+
+  if (ret != 0) { return ret; }
+
+  *buff = reg[1];
+  *buff = (*buff * 256) + reg[0];
+
+  return ret;
+}
+
+/**
+  * @brief  Decode the content of PRESS_OUT_XL..TEMP_OUT_H registers.
+  *
+  * @param  buff          Registers content (5 bytes).(ptr)
+  * @param  pressure      Pressure, as lps25hb_pressure_raw_get.(ptr)
+  * @param  temperature   Temperature, as lps25hb_temperature_raw_get.(ptr)
+  *
+  */
+static void lps25hb_sample_decode(const uint8_t *buff, uint32_t *pressure,
+                                  int16_t *temperature)
+{
+  *pressure = buff[2];
+  *pressure = (*pressure * 256U) + buff[1];
+  *pressure = (*pressure * 256U) + buff[0];
+  *pressure *= 256U;
+
+  *temperature = (int16_t)buff[4];
+  *temperature = (*temperature * 256) + (int16_t)buff[3];
+}
+
+/**
+  * @brief  Status, pressure and temperature output values read with a
+  *         single burst from STATUS_REG (27h) to TEMP_OUT_H (2Ch).[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Structure that stores data read.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_data_get(const stmdev_ctx_t *ctx, lps25hb_data_t *val)
+{
+  uint8_t buff[6];
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, buff, 6);
+
+  if (ret != 0) { return ret; }
+
+  *(uint8_t *)&val->status = buff[0];
+  lps25hb_sample_decode(&buff[1], &val->pressure, &val->temperature);
+
+  return ret;
+}
+
+/**
+  * @brief  The pressure offset value is 16-bit data that can be used to
+  *         implement one-point calibration (OPC) after soldering.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that contains data to write
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_offset_set(const stmdev_ctx_t *ctx, int16_t val)
+{
+  uint8_t buff[2];
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  buff[1] = (uint8_t)((uint16_t)val / 256U);
+  buff[0] = (uint8_t)((uint16_t)val - (buff[1] * 256U));
+  ret = lps25hb_shadow_write_reg(ctx, LPS25HB_RPDS_L,  buff, 2);
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  The pressure offset value is 16-bit data that can be used to
+  *         implement one-point calibration (OPC) after soldering.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that stores data read.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pressure_offset_get(const stmdev_ctx_t *ctx, int16_t *val)
+{
+  uint8_t buff[2];
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_RPDS_L,  buff, 2);
+
+  if (ret != 0) { return ret; }
+
+  *val = (int16_t)buff[1];
+  *val = (*val * 256) + (int16_t)buff[0];
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup   LPS25HB_common
+  * @brief      This section group common useful functions
+  * @{
+  *
+  */
+
+/**
+  * @brief  DeviceWhoamI.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  buff   Buffer that stores data read.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+{
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_WHO_AM_I,  buff, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Software reset. Restore the default values in user registers[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of swreset in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_reset_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.swreset = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Software reset. Restore the default values in user registers[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of swreset in reg CTRL_REG2.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_reset_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.swreset;
+
+  return ret;
+}
+
+/**
+  * @brief  Reboot memory content. Reload the calibration parameters[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of boot in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.boot = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Reboot memory content. Reload the calibration parameters[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of boot in reg CTRL_REG2.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.boot;
+
+  return ret;
+}
+
+/**
+  * @brief  Status: [get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get registers STATUS_REG.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_status_get(const stmdev_ctx_t *ctx,
+                           lps25hb_status_reg_t *val)
+{
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Read INT_SOURCE, STATUS_REG and FIFO_STATUS registers, in a
+  *         single bus transaction when read_multi is available.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get registers INT_SOURCE, STATUS_REG, FIFO_STATUS.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_all_sources_get(const stmdev_ctx_t *ctx,
+                                lps25hb_all_sources_t *val)
+{
+  lps25hb_seg_t seg[3];
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  seg[0].reg = LPS25HB_INT_SOURCE;
+  seg[0].data = (uint8_t *)&val->int_source;
+  seg[0].len = 1;
+  seg[1].reg = LPS25HB_STATUS_REG;
+  seg[1].data = (uint8_t *)&val->status_reg;
+  seg[1].len = 1;
+  seg[2].reg = LPS25HB_FIFO_STATUS;
+  seg[2].data = (uint8_t *)&val->fifo_status;
+  seg[2].len = 1;
+  ret = lps25hb_read_multi_reg(ctx, seg, 3);
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Check if a source routed on INT_DRDY pin is still active.
+  *         Data-ready and FIFO flags are level signals: with an edge
+  *         triggered host input (e.g. Linux GPIO line events) the
+  *         event handler must serve the sensor until this returns 0,
+  *         otherwise no further edge is generated.
+  *         FIFO empty (CTRL_REG4.f_empty) is not checked: the flag
+  *         stays set until new samples arrive, which serving the
+  *         sensor cannot bring about, so with it routed the pin can be
+  *         active while this returns 0.
+  *         In pressure interrupt modes INT_SOURCE is read, which
+  *         clears the latched interrupt.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    1 if a source to serve is active, 0 otherwise.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_pending_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg3_t ctrl_reg3;
+  lps25hb_ctrl_reg4_t ctrl_reg4;
+  lps25hb_status_reg_t status_reg;
+  lps25hb_fifo_status_t fifo_status;
+  lps25hb_int_source_t int_source;
+  lps25hb_seg_t seg[2];
+  int32_t ret;
+
+  *val = 0;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG3,
+                                (uint8_t *)&ctrl_reg3, 1);
+
+  if (ret == 0)
+  {
+    ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4,
+                                  (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  if ((ret == 0) &&
+      (ctrl_reg3.int_s == (uint8_t)LPS25HB_DRDY_OR_FIFO_FLAGS))
+  {
+    seg[0].reg = LPS25HB_STATUS_REG;
+    seg[0].data = (uint8_t *)&status_reg;
+    seg[0].len = 1;
+    seg[1].reg = LPS25HB_FIFO_STATUS;
+    seg[1].data = (uint8_t *)&fifo_status;
+    seg[1].len = 1;
+    ret = lps25hb_read_multi_reg(ctx, seg, 2);
+
+    if ((ret == 0) &&
+        (((ctrl_reg4.drdy != 0U) &&
+          ((status_reg.p_da != 0U) || (status_reg.t_da != 0U))) ||
+         ((ctrl_reg4.f_ovr != 0U) && (fifo_status.ovr != 0U)) ||
+         ((ctrl_reg4.f_fth != 0U) && (fifo_status.fth_fifo != 0U))))
+    {
+      *val = 1;
+    }
+  }
+  else if (ret == 0)
+  {
+    ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE,
+                           (uint8_t *)&int_source, 1);
+
+    if ((ret == 0) &&
+        ((((ctrl_reg3.int_s & (uint8_t)LPS25HB_HIGH_PRES_INT) != 0U) &&
+          (int_source.ph != 0U)) ||
+         (((ctrl_reg3.int_s & (uint8_t)LPS25HB_LOW_PRES_INT) != 0U) &&
+          (int_source.pl != 0U))))
+    {
+      *val = 1;
+    }
+  }
+  else
+  {
+    /* interface error */
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup   LPS25HB_interrupts
+  * @brief      This section group all the functions that manage interrupts
+  * @{
+  *
+  */
+
+/**
+  * @brief  Enable interrupt generation.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of diff_en in reg CTRL_REG1
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_generation_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.diff_en = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Enable interrupt generation.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of diff_en in reg CTRL_REG1.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_generation_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.diff_en;
+
+  return ret;
+}
+
+/**
+  * @brief  Data signal on INT_DRDY pin control bits.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of int_s in reg CTRL_REG3
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_pin_mode_set(const stmdev_ctx_t *ctx,
+                                 lps25hb_int_s_t val)
+{
+  lps25hb_ctrl_reg3_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.int_s = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Data signal on INT_DRDY pin control bits.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of int_s in reg CTRL_REG3.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_pin_mode_get(const stmdev_ctx_t *ctx,
+                                 lps25hb_int_s_t *val)
+{
+  lps25hb_ctrl_reg3_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.int_s)
+  {
+    case LPS25HB_DRDY_OR_FIFO_FLAGS:
+      *val = LPS25HB_DRDY_OR_FIFO_FLAGS;
+      break;
+
+    case LPS25HB_HIGH_PRES_INT:
+      *val = LPS25HB_HIGH_PRES_INT;
+      break;
+
+    case LPS25HB_LOW_PRES_INT:
+      *val = LPS25HB_LOW_PRES_INT;
+      break;
+
+    case LPS25HB_EVERY_PRES_INT:
+      *val = LPS25HB_EVERY_PRES_INT;
+      break;
+
+    default:
+      *val = LPS25HB_DRDY_OR_FIFO_FLAGS;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Push-pull/open drain selection on interrupt pads.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of pp_od in reg CTRL_REG3
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pin_mode_set(const stmdev_ctx_t *ctx, lps25hb_pp_od_t val)
+{
+  lps25hb_ctrl_reg3_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.pp_od = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Push-pull/open drain selection on interrupt pads.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of pp_od in reg CTRL_REG3.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_pin_mode_get(const stmdev_ctx_t *ctx, lps25hb_pp_od_t *val)
+{
+  lps25hb_ctrl_reg3_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.pp_od)
+  {
+    case LPS25HB_PUSH_PULL:
+      *val = LPS25HB_PUSH_PULL;
+      break;
+
+    case LPS25HB_OPEN_DRAIN:
+      *val = LPS25HB_OPEN_DRAIN;
+      break;
+
+    default:
+      *val = LPS25HB_PUSH_PULL;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Interrupt active-high/low.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of int_h_l in reg CTRL_REG3
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_polarity_set(const stmdev_ctx_t *ctx,
+                                 lps25hb_int_h_l_t val)
+{
+  lps25hb_ctrl_reg3_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.int_h_l = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Interrupt active-high/low.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of int_h_l in reg CTRL_REG3.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_int_polarity_get(const stmdev_ctx_t *ctx,
+                                 lps25hb_int_h_l_t *val)
+{
+  lps25hb_ctrl_reg3_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.int_h_l)
+  {
+    case LPS25HB_ACTIVE_HIGH:
+      *val = LPS25HB_ACTIVE_HIGH;
+      break;
+
+    case LPS25HB_ACTIVE_LOW:
+      *val = LPS25HB_ACTIVE_LOW;
+      break;
+
+    default:
+      *val = LPS25HB_ACTIVE_HIGH;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Data-ready signal on INT_DRDY pin.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of drdy in reg CTRL_REG4
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_drdy_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.drdy = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Data-ready signal on INT_DRDY pin.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of drdy in reg CTRL_REG4.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_drdy_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.drdy;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO overrun interrupt on INT_DRDY pin.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of f_ovr in reg CTRL_REG4
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_ovr_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.f_ovr = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO overrun interrupt on INT_DRDY pin.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of f_ovr in reg CTRL_REG4.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_ovr_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.f_ovr;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO watermark status on INT_DRDY pin.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of f_fth in reg CTRL_REG4
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_threshold_on_int_set(const stmdev_ctx_t *ctx,
+                                          uint8_t val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.f_fth = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO watermark status on INT_DRDY pin.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of f_fth in reg CTRL_REG4.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_threshold_on_int_get(const stmdev_ctx_t *ctx,
+                                          uint8_t *val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.f_fth;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO empty flag on INT_DRDY pin.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of f_empty in reg CTRL_REG4
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_empty_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.f_empty = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO empty flag on INT_DRDY pin.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of f_empty in reg CTRL_REG4.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_empty_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  lps25hb_ctrl_reg4_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.f_empty;
 
   return ret;
 }
 
 /**
-  * @brief  Pressure internal average configuration.[set]
+  * @brief  Enable interrupt generation on pressure low/high event.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of avgp in reg RES_CONF
+  * @param  val    Change the values of pe in reg INTERRUPT_CFG
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_pressure_avg_set(const stmdev_ctx_t *ctx,
-                                 lps25hb_avgp_t val)
+int32_t lps25hb_sign_of_int_threshold_set(const stmdev_ctx_t *ctx,
+                                          lps25hb_pe_t val)
 {
-  lps25hb_res_conf_t reg;
+  lps25hb_interrupt_cfg_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
 
   if (ret == 0)
   {
-    reg.avgp = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+    reg.pe = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_INTERRUPT_CFG,
+                                   (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Pressure internal average configuration.[get]
+  * @brief  Enable interrupt generation on pressure low/high event.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of avgp in reg RES_CONF.(ptr)
+  * @param  val    Get the values of pe in reg INTERRUPT_CFG.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_pressure_avg_get(const stmdev_ctx_t *ctx,
-                                 lps25hb_avgp_t *val)
+int32_t lps25hb_sign_of_int_threshold_get(const stmdev_ctx_t *ctx,
+                                          lps25hb_pe_t *val)
 {
-  lps25hb_res_conf_t reg;
+  lps25hb_interrupt_cfg_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.avgp)
+  switch (reg.pe)
   {
-    case LPS25HB_P_AVG_8:
-      *val = LPS25HB_P_AVG_8;
+    case LPS25HB_NO_THRESHOLD:
+      *val = LPS25HB_NO_THRESHOLD;
       break;
 
-    case LPS25HB_P_AVG_16:
-      *val = LPS25HB_P_AVG_16;
+    case LPS25HB_POSITIVE:
+      *val = LPS25HB_POSITIVE;
       break;
 
-    case LPS25HB_P_AVG_32:
-      *val = LPS25HB_P_AVG_32;
+    case LPS25HB_NEGATIVE:
+      *val = LPS25HB_NEGATIVE;
       break;
 
-    case LPS25HB_P_AVG_64:
-      *val = LPS25HB_P_AVG_64;
+    case LPS25HB_BOTH:
+      *val = LPS25HB_BOTH;
       break;
 
     default:
-      *val = LPS25HB_P_AVG_8;
+      *val = LPS25HB_NO_THRESHOLD;
       break;
   }
 
@@ -240,68 +2627,65 @@ int32_t lps25hb_pressure_avg_get(const stmdev_ctx_t *ctx,
 }
 
 /**
-  * @brief  Temperature internal average configuration.[set]
+  * @brief  Interrupt request to the INT_SOURCE (25h) register mode.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of avgt in reg RES_CONF
+  * @param  val    Change the values of lir in reg INTERRUPT_CFG
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_temperature_avg_set(const stmdev_ctx_t *ctx,
-                                    lps25hb_avgt_t val)
+int32_t lps25hb_int_notification_mode_set(const stmdev_ctx_t *ctx,
+                                          lps25hb_lir_t val)
 {
-  lps25hb_res_conf_t reg;
+  lps25hb_interrupt_cfg_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
 
   if (ret == 0)
   {
-    reg.avgt = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+    reg.lir = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_INTERRUPT_CFG,
+                                   (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Temperature internal average configuration.[get]
+  * @brief  Interrupt request to the  INT_SOURCE (25h) register mode.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of avgt in reg RES_CONF.(ptr)
+  * @param  val    Get the values of lir in reg INTERRUPT_CFG.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_temperature_avg_get(const stmdev_ctx_t *ctx,
-                                    lps25hb_avgt_t *val)
+int32_t lps25hb_int_notification_mode_get(const stmdev_ctx_t *ctx,
+                                          lps25hb_lir_t *val)
 {
-  lps25hb_res_conf_t reg;
+  lps25hb_interrupt_cfg_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_RES_CONF, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.avgt)
+  switch (reg.lir)
   {
-    case LPS25HB_T_AVG_8:
-      *val = LPS25HB_T_AVG_8;
-      break;
-
-    case LPS25HB_T_AVG_16:
-      *val = LPS25HB_T_AVG_16;
-      break;
-
-    case LPS25HB_T_AVG_32:
-      *val = LPS25HB_T_AVG_32;
+    case LPS25HB_INT_PULSED:
+      *val = LPS25HB_INT_PULSED;
       break;
 
-    case LPS25HB_T_AVG_64:
-      *val = LPS25HB_T_AVG_64;
+    case LPS25HB_INT_LATCHED:
+      *val = LPS25HB_INT_LATCHED;
       break;
 
     default:
-      *val = LPS25HB_T_AVG_8;
+      *val = LPS25HB_INT_PULSED;
       break;
   }
 
@@ -309,205 +2693,237 @@ int32_t lps25hb_temperature_avg_get(const stmdev_ctx_t *ctx,
 }
 
 /**
-  * @brief  Reset Autozero function. [set]
+  * @brief  Interrupt source register[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of reset_az in reg CTRL_REG1
+  * @param  val    Get registers INT_SOURCE.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_autozero_rst_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lps25hb_int_source_get(const stmdev_ctx_t *ctx,
+                               lps25hb_int_source_t *val)
 {
-  lps25hb_ctrl_reg1_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
-
-  if (ret == 0)
-  {
-    reg.reset_az = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
-  }
+  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *) val, 1);
 
   return ret;
 }
 
 /**
-  * @brief  Reset Autozero function.[get]
+  * @brief  Differential pressure high interrupt flag.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of reset_az in reg CTRL_REG1.(ptr)
+  * @param  val    Get the values of ph in reg INT_SOURCE.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_autozero_rst_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_int_on_press_high_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_ctrl_reg1_t reg;
+  lps25hb_int_source_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.reset_az;
+  *val = reg.ph;
 
   return ret;
 }
 
 /**
-  * @brief  Blockdataupdate.[set]
+  * @brief  Differential pressure low interrupt flag.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of bdu in reg CTRL_REG1
+  * @param  val    Get the values of pl in reg INT_SOURCE.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lps25hb_int_on_press_low_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_ctrl_reg1_t reg;
+  lps25hb_int_source_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *)&reg, 1);
 
-  if (ret == 0)
-  {
-    reg.bdu = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
-  }
+  if (ret != 0) { return ret; }
+
+  *val = reg.pl;
 
   return ret;
 }
 
 /**
-  * @brief Blockdataupdate. [get]
+  * @brief  Interrupt active flag.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of bdu in reg CTRL_REG1.(ptr)
+  * @param  val    Change the values of ia in reg INT_SOURCE
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_interrupt_event_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_ctrl_reg1_t reg;
+  lps25hb_int_source_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.bdu;
+  *val = reg.ia;
 
   return ret;
 }
 
 /**
-  * @brief  Output data rate selection.[set]
+  * @brief  User-defined threshold value for pressure interrupt event[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of odr in reg CTRL_REG1
+  * @param  buff   Buffer that contains data to write
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_data_rate_set(const stmdev_ctx_t *ctx, lps25hb_odr_t val)
+int32_t lps25hb_int_threshold_set(const stmdev_ctx_t *ctx, uint16_t val)
 {
-  lps25hb_ctrl_reg1_t reg;
+  uint8_t buff[2];
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
 
-  if (ret == 0)
-  {
-    reg.odr = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
-  }
+  buff[1] = (uint8_t)(val / 256U);
+  buff[0] = (uint8_t)(val - (buff[1] * 256U));
+  ret = lps25hb_shadow_write_reg(ctx, LPS25HB_THS_P_L,  buff, 2);
+
+  lps25hb_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  Output data rate selection.[get]
+  * @brief  User-defined threshold value for pressure interrupt event[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of odr in reg CTRL_REG1.(ptr)
+  * @param  buff   Buffer that stores data read.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_data_rate_get(const stmdev_ctx_t *ctx, lps25hb_odr_t *val)
+int32_t lps25hb_int_threshold_get(const stmdev_ctx_t *ctx, uint16_t *val)
 {
-  lps25hb_ctrl_reg1_t reg;
+  uint8_t buff[2];
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_THS_P_L,  buff, 2);
 
   if (ret != 0) { return ret; }
 
-  switch (reg.odr)
-  {
-    case LPS25HB_POWER_DOWN:
-      *val = LPS25HB_POWER_DOWN;
-      break;
+  *val = buff[1];
+  *val = (*val * 256) + buff[0];
 
-    case LPS25HB_ODR_1Hz:
-      *val = LPS25HB_ODR_1Hz;
-      break;
+  return ret;
+}
 
-    case LPS25HB_ODR_7Hz:
-      *val = LPS25HB_ODR_7Hz;
-      break;
+/**
+  * @}
+  *
+  */
 
-    case LPS25HB_ODR_12Hz5:
-      *val = LPS25HB_ODR_12Hz5;
-      break;
+/**
+  * @defgroup   LPS25HB_fifo
+  * @brief   This section group all the functions concerning the fifo usage
+  * @{
+  *
+  */
 
-    case LPS25HB_ODR_25Hz:
-      *val = LPS25HB_ODR_25Hz;
-      break;
+/**
+  * @brief  Stop on FIFO watermark. Enable FIFO watermark level use.[set]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Change the values of stop_on_fth in reg CTRL_REG2
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_stop_on_fifo_threshold_set(const stmdev_ctx_t *ctx,
+                                           uint8_t val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
 
-    case LPS25HB_ONE_SHOT:
-      *val = LPS25HB_ONE_SHOT;
-      break;
+  lps25hb_lock(ctx);
 
-    default:
-      *val = LPS25HB_POWER_DOWN;
-      break;
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.stop_on_fth = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  One-shot mode. Device perform a single measure.[set]
+  * @brief  Stop on FIFO watermark. Enable FIFO watermark level use.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of stop_on_fth in reg CTRL_REG2.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_stop_on_fifo_threshold_get(const stmdev_ctx_t *ctx,
+                                           uint8_t *val)
+{
+  lps25hb_ctrl_reg2_t reg;
+  int32_t ret;
+
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = reg.stop_on_fth;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFOenable.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of one_shot in reg CTRL_REG2
+  * @param  val    Change the values of fifo_en in reg CTRL_REG2
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_one_shoot_trigger_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lps25hb_fifo_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
   lps25hb_ctrl_reg2_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
 
   if (ret == 0)
   {
-    reg.one_shot = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    reg.fifo_en = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  One-shot mode. Device perform a single measure.[get]
+  * @brief  FIFOenable.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of one_shot in reg CTRL_REG2.(ptr)
+  * @param  val    Get the values of fifo_en in reg CTRL_REG2.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_one_shoot_trigger_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
   lps25hb_ctrl_reg2_t reg;
   int32_t ret;
@@ -516,284 +2932,336 @@ int32_t lps25hb_one_shoot_trigger_get(const stmdev_ctx_t *ctx, uint8_t *val)
 
   if (ret != 0) { return ret; }
 
-  *val = reg.one_shot;
+  *val = reg.fifo_en;
 
   return ret;
 }
 
 /**
-  * @brief  Enable Autozero function.[set]
+  * @brief  FIFO watermark level selection.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of autozero in reg CTRL_REG2
+  * @param  val    Change the values of wtm_point in reg FIFO_CTRL
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_autozero_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lps25hb_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lps25hb_ctrl_reg2_t reg;
+  lps25hb_fifo_ctrl_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
 
   if (ret == 0)
   {
-    reg.autozero = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    reg.wtm_point = val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Enable Autozero function.[get]
+  * @brief  FIFO watermark level selection.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of autozero in reg CTRL_REG2.(ptr)
+  * @param  val    Get the values of wtm_point in reg FIFO_CTRL.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_autozero_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_ctrl_reg2_t reg;
+  lps25hb_fifo_ctrl_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.autozero;
+  *val = reg.wtm_point;
 
   return ret;
 }
 
 /**
-  * @brief  Enable to decimate the output pressure to 1Hz
-  *         with FIFO Mean mode.[set]
+  * @brief  FIFO mode selection.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of fifo_mean_dec in reg CTRL_REG2
+  * @param  val    Change the values of f_mode in reg FIFO_CTRL
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_fifo_mean_decimator_set(const stmdev_ctx_t *ctx,
-                                        uint8_t val)
+int32_t lps25hb_fifo_mode_set(const stmdev_ctx_t *ctx, lps25hb_f_mode_t val)
 {
-  lps25hb_ctrl_reg2_t reg;
+  lps25hb_fifo_ctrl_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
 
   if (ret == 0)
   {
-    reg.fifo_mean_dec = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    reg.f_mode = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Enable to decimate the output pressure to 1Hz
-  *         with FIFO Mean mode.[get]
+  * @brief  FIFO mode selection.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of fifo_mean_dec in reg CTRL_REG2
+  * @param  val    Get the values of f_mode in reg FIFO_CTRL.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_fifo_mean_decimator_get(const stmdev_ctx_t *ctx,
-                                        uint8_t *val)
+int32_t lps25hb_fifo_mode_get(const stmdev_ctx_t *ctx,
+                              lps25hb_f_mode_t *val)
 {
-  lps25hb_ctrl_reg2_t reg;
+  lps25hb_fifo_ctrl_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.fifo_mean_dec;
+  switch (reg.f_mode)
+  {
+    case LPS25HB_BYPASS_MODE:
+      *val = LPS25HB_BYPASS_MODE;
+      break;
+
+    case LPS25HB_FIFO_MODE:
+      *val = LPS25HB_FIFO_MODE;
+      break;
+
+    case LPS25HB_STREAM_MODE:
+      *val = LPS25HB_STREAM_MODE;
+      break;
+
+    case LPS25HB_Stream_to_FIFO_mode:
+      *val = LPS25HB_Stream_to_FIFO_mode;
+      break;
+
+    case LPS25HB_BYPASS_TO_STREAM_MODE:
+      *val = LPS25HB_BYPASS_TO_STREAM_MODE;
+      break;
+
+    case LPS25HB_MEAN_MODE:
+      *val = LPS25HB_MEAN_MODE;
+      break;
+
+    case LPS25HB_BYPASS_TO_FIFO_MODE:
+      *val = LPS25HB_BYPASS_TO_FIFO_MODE;
+      break;
+
+    default:
+      *val = LPS25HB_BYPASS_MODE;
+      break;
+  }
 
   return ret;
 }
 
 /**
-  * @brief  Pressure data available.[get]
+  * @brief  FIFO status register. [get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of p_da in reg STATUS_REG.(ptr)
+  * @param  lps25hb_: registers FIFO_STATUS.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_press_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_status_get(const stmdev_ctx_t *ctx,
+                                lps25hb_fifo_status_t *val)
 {
-  lps25hb_status_reg_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = reg.p_da;
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *) val, 1);
 
   return ret;
 }
 
 /**
-  * @brief  Temperature data available.[get]
+  * @brief  FIFO stored data level.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of t_da in reg STATUS_REG.(ptr)
+  * @param  val    Get the values of fss in reg FIFO_STATUS.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_temp_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_data_level_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_status_reg_t reg;
+  lps25hb_fifo_status_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.t_da;
+  *val = reg.fss;
 
   return ret;
 }
 
 /**
-  * @brief  Temperature data overrun.[get]
+  * @brief  Empty FIFO status flag.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of t_or in reg STATUS_REG.(ptr)
+  * @param  val    Get the values of empty_fifo in reg FIFO_STATUS.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_temp_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_empty_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_status_reg_t reg;
+  lps25hb_fifo_status_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.t_or;
+  *val = reg.empty_fifo;
 
   return ret;
 }
 
 /**
-  * @brief  Pressure data overrun.[get]
+  * @brief  FIFO overrun status flag.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of p_or in reg STATUS_REG.(ptr)
+  * @param  val    Get the values of ovr in reg FIFO_STATUS.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_press_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lps25hb_status_reg_t reg;
+  lps25hb_fifo_status_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *)&reg, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = reg.p_or;
+  *val = reg.ovr;
 
   return ret;
 }
 
 /**
-  * @brief  Pressure output value.[get]
+  * @brief  FIFO watermark status.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that stores data read.(ptr)
+  * @param  val    Change the values of fth_fifo in reg FIFO_STATUS.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_pressure_raw_get(const stmdev_ctx_t *ctx, uint32_t *buff)
+int32_t lps25hb_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  uint8_t reg[3];
+  lps25hb_fifo_status_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_PRESS_OUT_XL,  reg, 3);
+  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
 
   if (ret != 0) { return ret; }
 
-  *buff = reg[2];
-  *buff = (*buff * 256) + reg[1];
-  *buff = (*buff * 256) + reg[0];
-  *buff *= 256;
+  *val = reg.fth_fifo;
 
   return ret;
 }
 
 /**
-  * @brief  Temperature output value.[get]
+  * @brief  Read and decode one sample from FIFO, with a single burst from
+  *         PRESS_OUT_XL (28h) to TEMP_OUT_H (2Ch).
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that stores data read.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ctx           Read / write interface definitions.(ptr)
+  * @param  pressure      Pressure, as lps25hb_pressure_raw_get.(ptr)
+  * @param  temperature   Temperature, as lps25hb_temperature_raw_get.(ptr)
+  * @retval               Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_temperature_raw_get(const stmdev_ctx_t *ctx, int16_t *buff)
+static int32_t lps25hb_fifo_sample_read(const stmdev_ctx_t *ctx,
+                                        uint32_t *pressure,
+                                        int16_t *temperature)
 {
-  uint8_t reg[2];
+  uint8_t buff[LPS25HB_SAMPLE_LEN];
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_TEMP_OUT_L,  reg, 2);
-
-  if (ret != 0) { return ret; }
+  ret = lps25hb_read_reg(ctx, LPS25HB_PRESS_OUT_XL, buff,
+                         (uint16_t)LPS25HB_SAMPLE_LEN);
 
-  *buff = reg[1];
-  *buff = (*buff * 256) + reg[0];
+  if (ret == 0)
+  {
+    lps25hb_sample_decode(buff, pressure, temperature);
+  }
 
   return ret;
 }
 
 /**
-  * @brief  The pressure offset value is 16-bit data that can be used to
-  *         implement one-point calibration (OPC) after soldering.[set]
+  * @brief  Read samples stored in FIFO. Each sample is read with a single
+  *         burst from PRESS_OUT_XL (28h) to TEMP_OUT_H (2Ch).[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that contains data to write
+  * @param  val    Buffer that stores the samples read.(ptr)
+  * @param  num    Number of samples to read (see lps25hb_fifo_data_level_get)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_pressure_offset_set(const stmdev_ctx_t *ctx, int16_t val)
+int32_t lps25hb_fifo_data_get(const stmdev_ctx_t *ctx,
+                              lps25hb_fifo_sample_t *val, uint8_t num)
 {
-  uint8_t buff[2];
-  int32_t ret;
+  uint8_t i;
+  int32_t ret = 0;
 
-  buff[1] = (uint8_t)((uint16_t)val / 256U);
-  buff[0] = (uint8_t)((uint16_t)val - (buff[1] * 256U));
-  ret = lps25hb_write_reg(ctx, LPS25HB_RPDS_L,  buff, 2);
+  lps25hb_lock(ctx);
+
+  for (i = 0; (i < num) && (ret == 0); i++)
+  {
+    ret = lps25hb_fifo_sample_read(ctx, &val[i].pressure,
+                                   &val[i].temperature);
+  }
+
+  lps25hb_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  The pressure offset value is 16-bit data that can be used to
-  *         implement one-point calibration (OPC) after soldering.[get]
+  * @brief  Read samples stored in FIFO without decoding them. Each
+  *         sample is read with a single burst from PRESS_OUT_XL (28h)
+  *         to TEMP_OUT_H (2Ch) into consecutive LPS25HB_SAMPLE_LEN
+  *         bytes of buff, see lps25hb_from_raw_to_units.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that stores data read.(ptr)
+  * @param  buff   Buffer of num * LPS25HB_SAMPLE_LEN bytes.(ptr)
+  * @param  num    Number of samples to read (see lps25hb_fifo_data_level_get)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_pressure_offset_get(const stmdev_ctx_t *ctx, int16_t *val)
+int32_t lps25hb_fifo_raw_get(const stmdev_ctx_t *ctx, uint8_t *buff,
+                             uint8_t num)
 {
-  uint8_t buff[2];
-  int32_t ret;
+  uint8_t i;
+  int32_t ret = 0;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_RPDS_L,  buff, 2);
+  lps25hb_lock(ctx);
 
-  if (ret != 0) { return ret; }
+  for (i = 0; (i < num) && (ret == 0); i++)
+  {
+    ret = lps25hb_read_reg(ctx, LPS25HB_PRESS_OUT_XL,
+                           &buff[(uint16_t)i * LPS25HB_SAMPLE_LEN],
+                           (uint16_t)LPS25HB_SAMPLE_LEN);
+  }
 
-  *val = (int16_t)buff[1];
-  *val = (*val * 256) + (int16_t)buff[0];
+  lps25hb_unlock(ctx);
 
   return ret;
 }
@@ -804,62 +3272,115 @@ int32_t lps25hb_pressure_offset_get(const stmdev_ctx_t *ctx, int16_t *val)
   */
 
 /**
-  * @defgroup   LPS25HB_common
-  * @brief      This section group common useful functions
+  * @defgroup   LPS25HB_serial_interface
+  * @brief      This section group all the functions concerning serial
+  *             interface management
   * @{
   *
   */
 
 /**
-  * @brief  DeviceWhoamI.[get]
+  * @brief  SPI Serial Interface Mode selection.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that stores data read.(ptr)
+  * @param  val    Change the values of sim in reg CTRL_REG1
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff)
+int32_t lps25hb_spi_mode_set(const stmdev_ctx_t *ctx, lps25hb_sim_t val)
+{
+  lps25hb_ctrl_reg1_t reg;
+  int32_t ret;
+
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret == 0)
+  {
+    reg.sim = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  }
+
+  lps25hb_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  SPI Serial Interface Mode selection.[get]
+  *
+  * @param  ctx    Read / write interface definitions.(ptr)
+  * @param  val    Get the values of sim in reg CTRL_REG1.(ptr)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_spi_mode_get(const stmdev_ctx_t *ctx, lps25hb_sim_t *val)
 {
+  lps25hb_ctrl_reg1_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_WHO_AM_I,  buff, 1);
+  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (reg.sim)
+  {
+    case LPS25HB_SPI_4_WIRE:
+      *val = LPS25HB_SPI_4_WIRE;
+      break;
+
+    case LPS25HB_SPI_3_WIRE:
+      *val = LPS25HB_SPI_3_WIRE;
+      break;
+
+    default:
+      *val = LPS25HB_SPI_4_WIRE;
+      break;
+  }
 
   return ret;
 }
 
 /**
-  * @brief  Software reset. Restore the default values in user registers[set]
+  * @brief  Disable I2C interface.[set]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of swreset in reg CTRL_REG2
+  * @param  val    Change the values of i2c_dis in reg CTRL_REG2
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_reset_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lps25hb_i2c_interface_set(const stmdev_ctx_t *ctx,
+                                  lps25hb_i2c_dis_t val)
 {
   lps25hb_ctrl_reg2_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
 
   if (ret == 0)
   {
-    reg.swreset = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    reg.i2c_dis = (uint8_t)val;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Software reset. Restore the default values in user registers[get]
+  * @brief  Disable I2C interface.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of swreset in reg CTRL_REG2.(ptr)
+  * @param  val    Get the values of i2c_dis in reg CTRL_REG2.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_reset_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_i2c_interface_get(const stmdev_ctx_t *ctx,
+                                  lps25hb_i2c_dis_t *val)
 {
   lps25hb_ctrl_reg2_t reg;
   int32_t ret;
@@ -868,71 +3389,190 @@ int32_t lps25hb_reset_get(const stmdev_ctx_t *ctx, uint8_t *val)
 
   if (ret != 0) { return ret; }
 
-  *val = reg.swreset;
+  switch (reg.i2c_dis)
+  {
+    case LPS25HB_I2C_ENABLE:
+      *val = LPS25HB_I2C_ENABLE;
+      break;
+
+    case LPS25HB_I2C_DISABLE:
+      *val = LPS25HB_I2C_DISABLE;
+      break;
+
+    default:
+      *val = LPS25HB_I2C_ENABLE;
+      break;
+  }
 
   return ret;
 }
 
 /**
-  * @brief  Reboot memory content. Reload the calibration parameters[set]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of boot in reg CTRL_REG2
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @}
   *
   */
-int32_t lps25hb_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
-{
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
-
-  if (ret == 0)
-  {
-    reg.boot = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
-  }
 
-  return ret;
-}
+/**
+  * @defgroup   LPS25HB_configuration
+  * @brief      This section group the functions that apply a complete
+  *             device configuration with burst writes
+  * @{
+  *
+  */
 
 /**
-  * @brief  Reboot memory content. Reload the calibration parameters[get]
+  * @brief  Append to a segment list the bytes of a register range to
+  *         write. With LPS25HB_CFG_WRITE_CHANGED the range is trimmed to
+  *         the bytes that differ from the register shadow.
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of boot in reg CTRL_REG2.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  seg    Segment list.(ptr)
+  * @param  num    Number of segments in the list.(ptr)
+  * @param  reg    First register of the range
+  * @param  data   Register range content.(ptr)
+  * @param  len    Number of consecutive registers
+  * @param  mode   LPS25HB_CFG_WRITE_ALL / LPS25HB_CFG_WRITE_CHANGED
   *
   */
-int32_t lps25hb_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static void lps25hb_cfg_seg_add(const stmdev_ctx_t *ctx, lps25hb_seg_t *seg,
+                                uint16_t *num, uint8_t reg, uint8_t *data,
+                                uint16_t len, lps25hb_cfg_write_t mode)
 {
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  const lps25hb_shadow_t *shadow;
+  uint16_t first = 0;
+  uint16_t last = len;
+  uint8_t idx;
 
-  if (ret != 0) { return ret; }
+  shadow = lps25hb_shadow_ptr(ctx);
 
-  *val = reg.boot;
+  if ((mode == LPS25HB_CFG_WRITE_CHANGED) && (shadow != NULL))
+  {
+    while (first < last)
+    {
+      idx = (uint8_t)((uint16_t)reg + first - LPS25HB_SHADOW_FIRST);
+
+      if (((shadow->valid & LPS25HB_SHADOW_BIT(reg + first)) == 0U) ||
+          (shadow->reg[idx] != data[first]))
+      {
+        break;
+      }
+
+      first++;
+    }
+
+    while (last > first)
+    {
+      idx = (uint8_t)((uint16_t)reg + last - 1U - LPS25HB_SHADOW_FIRST);
+
+      if (((shadow->valid & LPS25HB_SHADOW_BIT(reg + last - 1U)) == 0U) ||
+          (shadow->reg[idx] != data[last - 1U]))
+      {
+        break;
+      }
+
+      last--;
+    }
+  }
 
-  return ret;
+  if (first < last)
+  {
+    seg[*num].reg = reg + (uint8_t)first;
+    seg[*num].data = &data[first];
+    seg[*num].len = last - first;
+    *num += 1U;
+  }
 }
 
 /**
-  * @brief  Status: [get]
+  * @brief  Apply a complete device configuration. The register image is
+  *         written with one burst per contiguous range (RES_CONF,
+  *         CTRL_REG1..INTERRUPT_CFG, FIFO_CTRL, THS_P, RPDS), in a single
+  *         transaction when write_multi is available. With
+  *         LPS25HB_CFG_WRITE_CHANGED and the register shadow enabled only
+  *         the bytes that differ from the shadow are written.
+  *         BOOT, SWRESET, ONE_SHOT, AUTO_ZERO and RESET_AZ are written
+  *         as 0.
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get registers STATUS_REG.(ptr)
+  * @param  val    Configuration to apply.(ptr)
+  * @param  mode   LPS25HB_CFG_WRITE_ALL / LPS25HB_CFG_WRITE_CHANGED
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_status_get(const stmdev_ctx_t *ctx,
-                           lps25hb_status_reg_t *val)
+int32_t lps25hb_cfg_commit(const stmdev_ctx_t *ctx, const lps25hb_cfg_t *val,
+                           lps25hb_cfg_write_t mode)
 {
-  int32_t ret;
+  lps25hb_res_conf_t res_conf = { 0 };
+  lps25hb_ctrl_reg1_t ctrl_reg1 = { 0 };
+  lps25hb_ctrl_reg2_t ctrl_reg2 = { 0 };
+  lps25hb_ctrl_reg3_t ctrl_reg3 = { 0 };
+  lps25hb_ctrl_reg4_t ctrl_reg4 = { 0 };
+  lps25hb_interrupt_cfg_t interrupt_cfg = { 0 };
+  lps25hb_fifo_ctrl_t fifo_ctrl = { 0 };
+  lps25hb_seg_t seg[5];
+  uint8_t ctrl[5];
+  uint8_t ths_p[2];
+  uint8_t rpds[2];
+  uint16_t num = 0;
+  int32_t ret = 0;
+
+  res_conf.avgp = (uint8_t)val->pressure_avg;
+  res_conf.avgt = (uint8_t)val->temperature_avg;
+
+  ctrl_reg1.sim = (uint8_t)val->spi_mode;
+  ctrl_reg1.bdu = val->bdu;
+  ctrl_reg1.diff_en = val->int_generation;
+  ctrl_reg1.odr = (uint8_t)val->odr;
+
+  ctrl_reg2.i2c_dis = (uint8_t)val->i2c_interface;
+  ctrl_reg2.fifo_mean_dec = val->fifo_mean_dec;
+  ctrl_reg2.stop_on_fth = val->stop_on_fth;
+  ctrl_reg2.fifo_en = val->fifo_en;
+
+  ctrl_reg3.int_s = (uint8_t)val->int_pin_mode;
+  ctrl_reg3.pp_od = (uint8_t)val->pin_mode;
+  ctrl_reg3.int_h_l = (uint8_t)val->int_polarity;
+
+  ctrl_reg4.drdy = val->drdy_on_int;
+  ctrl_reg4.f_ovr = val->fifo_ovr_on_int;
+  ctrl_reg4.f_fth = val->fifo_threshold_on_int;
+  ctrl_reg4.f_empty = val->fifo_empty_on_int;
+
+  interrupt_cfg.pe = (uint8_t)val->sign_of_int_threshold;
+  interrupt_cfg.lir = (uint8_t)val->int_notification_mode;
+
+  fifo_ctrl.wtm_point = val->fifo_watermark;
+  fifo_ctrl.f_mode = (uint8_t)val->fifo_mode;
+
+  ctrl[0] = *(uint8_t *)&ctrl_reg1;
+  ctrl[1] = *(uint8_t *)&ctrl_reg2;
+  ctrl[2] = *(uint8_t *)&ctrl_reg3;
+  ctrl[3] = *(uint8_t *)&ctrl_reg4;
+  ctrl[4] = *(uint8_t *)&interrupt_cfg;
+
+  ths_p[1] = (uint8_t)(val->int_threshold / 256U);
+  ths_p[0] = (uint8_t)(val->int_threshold - (ths_p[1] * 256U));
+
+  rpds[1] = (uint8_t)((uint16_t)val->pressure_offset / 256U);
+  rpds[0] = (uint8_t)((uint16_t)val->pressure_offset - (rpds[1] * 256U));
+
+  /* the shadow compared by lps25hb_cfg_seg_add must not change */
+  lps25hb_lock(ctx);
+
+  lps25hb_cfg_seg_add(ctx, seg, &num, LPS25HB_RES_CONF,
+                      (uint8_t *)&res_conf, 1, mode);
+  lps25hb_cfg_seg_add(ctx, seg, &num, LPS25HB_CTRL_REG1, ctrl, 5, mode);
+  lps25hb_cfg_seg_add(ctx, seg, &num, LPS25HB_FIFO_CTRL,
+                      (uint8_t *)&fifo_ctrl, 1, mode);
+  lps25hb_cfg_seg_add(ctx, seg, &num, LPS25HB_THS_P_L, ths_p, 2, mode);
+  lps25hb_cfg_seg_add(ctx, seg, &num, LPS25HB_RPDS_L, rpds, 2, mode);
+
+  if (num != 0U)
+  {
+    ret = lps25hb_write_multi_reg(ctx, seg, num);
+  }
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_STATUS_REG, (uint8_t *) val, 1);
+  lps25hb_unlock(ctx);
 
   return ret;
 }
@@ -943,1159 +3583,1930 @@ int32_t lps25hb_status_get(const stmdev_ctx_t *ctx,
   */
 
 /**
-  * @defgroup   LPS25HB_interrupts
-  * @brief      This section group all the functions that manage interrupts
+  * @defgroup   LPS25HB_ucf
+  * @brief      This section group the functions that load a configuration
+  *             generated by Unico / Unicleo tools
   * @{
   *
   */
 
+#define LPS25HB_UCF_BURST_MAX   16U
+
 /**
-  * @brief  Enable interrupt generation.[set]
+  * @brief  Get the bits of a register that can be compared with the
+  *         value written, i.e. without the self-clearing ones.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of diff_en in reg CTRL_REG1
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  reg    Register address
+  * @retval        Mask of the bits to compare
   *
   */
-int32_t lps25hb_int_generation_set(const stmdev_ctx_t *ctx, uint8_t val)
+static uint8_t lps25hb_ucf_mask(uint8_t reg)
 {
-  lps25hb_ctrl_reg1_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  lps25hb_ctrl_reg1_t ctrl_reg1;
+  lps25hb_ctrl_reg2_t ctrl_reg2;
+  uint8_t mask = 0xFFU;
 
-  if (ret == 0)
+  if (reg == LPS25HB_CTRL_REG1)
   {
-    reg.diff_en = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+    *(uint8_t *)&ctrl_reg1 = 0xFFU;
+    ctrl_reg1.reset_az = PROPERTY_DISABLE;
+    mask = *(uint8_t *)&ctrl_reg1;
+  }
+  else if (reg == LPS25HB_CTRL_REG2)
+  {
+    *(uint8_t *)&ctrl_reg2 = 0xFFU;
+    ctrl_reg2.one_shot = PROPERTY_DISABLE;
+    ctrl_reg2.autozero = PROPERTY_DISABLE;
+    ctrl_reg2.swreset = PROPERTY_DISABLE;
+    ctrl_reg2.boot = PROPERTY_DISABLE;
+    mask = *(uint8_t *)&ctrl_reg2;
+  }
+  else
+  {
+    /* all bits are compared */
   }
 
-  return ret;
+  return mask;
 }
 
 /**
-  * @brief  Enable interrupt generation.[get]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of diff_en in reg CTRL_REG1.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @brief  Load a sequence of address / data lines (e.g. from a UCF file).
+  *         Lines addressing consecutive registers are merged and written
+  *         with a single burst. If verify is set, each burst is read back
+  *         with a single burst and compared with the written data.
+  *
+  * @param  ctx      Read / write interface definitions.(ptr)
+  * @param  val      Lines to load.(ptr)
+  * @param  num      Number of lines
+  * @param  verify   Read back and compare the written registers
+  * @retval          Interface status (MANDATORY: return 0 -> no Error),
+  *                  -1 if a register read back differs from the UCF.
   *
   */
-int32_t lps25hb_int_generation_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_load_ucf(const stmdev_ctx_t *ctx, const ucf_line_t *val,
+                         uint16_t num, uint8_t verify)
 {
-  lps25hb_ctrl_reg1_t reg;
-  int32_t ret;
+  uint8_t buff[LPS25HB_UCF_BURST_MAX];
+  uint8_t check[LPS25HB_UCF_BURST_MAX];
+  uint16_t len;
+  uint16_t i = 0;
+  uint16_t j;
+  int32_t ret = 0;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
 
-  if (ret != 0) { return ret; }
+  while ((i < num) && (ret == 0))
+  {
+    len = 0;
+
+    do
+    {
+      buff[len] = val[i + len].data;
+      len++;
+    } while (((i + len) < num) && (len < LPS25HB_UCF_BURST_MAX) &&
+             (val[i + len].address == (val[i].address + len)));
+
+    ret = lps25hb_shadow_write_reg(ctx, val[i].address, buff, len);
+
+    if ((ret == 0) && (verify != 0U))
+    {
+      ret = lps25hb_read_reg(ctx, val[i].address, check, len);
+
+      for (j = 0; (j < len) && (ret == 0); j++)
+      {
+        if (((buff[j] ^ check[j]) &
+             lps25hb_ucf_mask(val[i].address + (uint8_t)j)) != 0U)
+        {
+          ret = -1;
+        }
+      }
+    }
+
+    i += len;
+  }
 
-  *val = reg.diff_en;
+  lps25hb_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  Data signal on INT_DRDY pin control bits.[set]
+  * @}
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of int_s in reg CTRL_REG3
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  */
+
+/**
+  * @defgroup   LPS25HB_async
+  * @brief      This section group the non-blocking versions of the data
+  *             and FIFO read functions. The request is submitted to the
+  *             read_async routine in priv_data and decoded when the
+  *             transfer completes, then req->done(req->arg, status) is
+  *             called. Without read_async the request completes before
+  *             the function returns.
+  * @{
   *
   */
-int32_t lps25hb_int_pin_mode_set(const stmdev_ctx_t *ctx,
-                                 lps25hb_int_s_t val)
-{
-  lps25hb_ctrl_reg3_t reg;
-  int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+#define LPS25HB_ASYNC_IDLE        0U
+#define LPS25HB_ASYNC_SUBMITTING  1U
+#define LPS25HB_ASYNC_COMPLETED   2U
+
+/*
+ * Atomic compare-and-swap of the request state, true if swapped.
+ * Without LPS25HB_SYNC_BUILTINS it must be defined when the transfer
+ * completion runs on another core than the submission.
+ */
+#ifndef LPS25HB_ASYNC_CAS
+#if (LPS25HB_SYNC_BUILTINS == 1)
+#define LPS25HB_ASYNC_CAS(ptr, old, val) \
+  __sync_bool_compare_and_swap((ptr), (old), (val))
+#else
+#define LPS25HB_ASYNC_CAS(ptr, old, val)  lps25hb_async_cas((ptr), (old), (val))
 
-  if (ret == 0)
+/**
+  * @brief  Compare-and-swap of the request state, for single core use.
+  *
+  * @param  ptr    Request state.(ptr)
+  * @param  old    Expected state
+  * @param  val    New state
+  * @retval        1 if the state was old and is now val, 0 otherwise
+  *
+  */
+static uint8_t lps25hb_async_cas(volatile uint8_t *ptr, uint8_t old,
+                                 uint8_t val)
+{
+  if (*ptr != old)
   {
-    reg.int_s = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+    return 0;
   }
 
-  return ret;
+  *ptr = val;
+
+  return 1;
 }
+#endif /* LPS25HB_SYNC_BUILTINS */
+#endif /* LPS25HB_ASYNC_CAS */
+
+static int32_t lps25hb_async_run(lps25hb_async_t *req, uint8_t first);
 
 /**
-  * @brief  Data signal on INT_DRDY pin control bits.[get]
+  * @brief  Registers read by each transfer of a request.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of int_s in reg CTRL_REG3.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  req    Asynchronous request.(ptr)
+  * @param  len    Number of consecutive registers.(ptr)
+  * @retval        First register
   *
   */
-int32_t lps25hb_int_pin_mode_get(const stmdev_ctx_t *ctx,
-                                 lps25hb_int_s_t *val)
+static uint8_t lps25hb_async_reg(const lps25hb_async_t *req, uint16_t *len)
 {
-  lps25hb_ctrl_reg3_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  switch (reg.int_s)
+  if (req->data != NULL)
   {
-    case LPS25HB_DRDY_OR_FIFO_FLAGS:
-      *val = LPS25HB_DRDY_OR_FIFO_FLAGS;
-      break;
-
-    case LPS25HB_HIGH_PRES_INT:
-      *val = LPS25HB_HIGH_PRES_INT;
-      break;
-
-    case LPS25HB_LOW_PRES_INT:
-      *val = LPS25HB_LOW_PRES_INT;
-      break;
-
-    case LPS25HB_EVERY_PRES_INT:
-      *val = LPS25HB_EVERY_PRES_INT;
-      break;
-
-    default:
-      *val = LPS25HB_DRDY_OR_FIFO_FLAGS;
-      break;
+    *len = 6;
+    return LPS25HB_STATUS_REG;
   }
 
-  return ret;
+  *len = 5;
+
+  return LPS25HB_PRESS_OUT_XL;
 }
 
 /**
-  * @brief  Push-pull/open drain selection on interrupt pads.[set]
+  * @brief  Decode the chunk read by an asynchronous request.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of pp_od in reg CTRL_REG3
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  req    Asynchronous request.(ptr)
+  * @retval        1 if another chunk has to be read, 0 if the request is
+  *                over and the caller was notified
   *
   */
-int32_t lps25hb_pin_mode_set(const stmdev_ctx_t *ctx, lps25hb_pp_od_t val)
+static uint8_t lps25hb_async_step(lps25hb_async_t *req)
 {
-  lps25hb_ctrl_reg3_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  if ((req->status == 0) && (req->data != NULL))
+  {
+    *(uint8_t *)&req->data->status = req->buff[0];
+    lps25hb_sample_decode(&req->buff[1], &req->data->pressure,
+                          &req->data->temperature);
+  }
+  else if (req->status == 0)
+  {
+    lps25hb_sample_decode(req->buff, &req->sample[req->idx].pressure,
+                          &req->sample[req->idx].temperature);
+    req->idx++;
+
+    if (req->idx < req->num)
+    {
+      return 1;
+    }
+  }
+  else
+  {
+    /* transfer error reported to the caller */
+  }
 
-  if (ret == 0)
+  if (req->done != NULL)
   {
-    reg.pp_od = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+    req->done(req->arg, req->status);
   }
 
-  return ret;
+  return 0;
 }
 
 /**
-  * @brief  Push-pull/open drain selection on interrupt pads.[get]
+  * @brief  Transfer completion of an asynchronous request. A transfer
+  *         completed before read_async returned is left to the
+  *         submission loop, so that the stack does not grow with the
+  *         number of chunks.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of pp_od in reg CTRL_REG3.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  arg      Asynchronous request.(ptr)
+  * @param  status   Interface status of the transfer
   *
   */
-int32_t lps25hb_pin_mode_get(const stmdev_ctx_t *ctx, lps25hb_pp_od_t *val)
+static void lps25hb_async_complete(void *arg, int32_t status)
 {
-  lps25hb_ctrl_reg3_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  lps25hb_async_t *req = (lps25hb_async_t *)arg;
+#ifdef LPS25HB_INSTRUMENTATION
+  const lps25hb_priv_t *priv;
+  uint16_t len;
+  uint8_t reg;
 
-  if (ret != 0) { return ret; }
+  priv = (const lps25hb_priv_t *)req->ctx->priv_data;
 
-  switch (reg.pp_od)
+  if ((priv != NULL) && (priv->read_async != NULL))
   {
-    case LPS25HB_PUSH_PULL:
-      *val = LPS25HB_PUSH_PULL;
-      break;
+    /* the synchronous fallback is accounted by lps25hb_read_reg */
+    reg = lps25hb_async_reg(req, &len);
+    lps25hb_stats_record(req->ctx, reg, len, 0, status, req->start);
+  }
+#endif /* LPS25HB_INSTRUMENTATION */
 
-    case LPS25HB_OPEN_DRAIN:
-      *val = LPS25HB_OPEN_DRAIN;
-      break;
+  req->status = status;
 
-    default:
-      *val = LPS25HB_PUSH_PULL;
-      break;
+  if (LPS25HB_ASYNC_CAS(&req->state, LPS25HB_ASYNC_SUBMITTING,
+                        LPS25HB_ASYNC_COMPLETED))
+  {
+    return;
   }
 
-  return ret;
+  if (lps25hb_async_step(req) != 0U)
+  {
+    /* a submission error is reported through done */
+    (void)lps25hb_async_run(req, 0);
+  }
 }
 
 /**
-  * @brief  Interrupt active-high/low.[set]
+  * @brief  Start the read of the current chunk of a request.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of int_h_l in reg CTRL_REG3
+  * @param  req    Asynchronous request.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_int_polarity_set(const stmdev_ctx_t *ctx,
-                                 lps25hb_int_h_l_t val)
+static int32_t lps25hb_async_start(lps25hb_async_t *req)
 {
-  lps25hb_ctrl_reg3_t reg;
+  const lps25hb_priv_t *priv;
+  uint16_t len;
+  uint8_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  reg = lps25hb_async_reg(req, &len);
+  priv = (const lps25hb_priv_t *)req->ctx->priv_data;
 
-  if (ret == 0)
+  if ((priv != NULL) && (priv->read_async != NULL))
   {
-    reg.int_h_l = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+#ifdef LPS25HB_INSTRUMENTATION
+    req->start = lps25hb_stats_tick(req->ctx);
+#endif /* LPS25HB_INSTRUMENTATION */
+    ret = priv->read_async(req->ctx->handle,
+                           lps25hb_bus_address(req->ctx, reg, len),
+                           req->buff, len, lps25hb_async_complete, req);
+  }
+  else
+  {
+    /* no read_async: complete on the caller context */
+    ret = lps25hb_read_reg(req->ctx, reg, req->buff, len);
+    lps25hb_async_complete(req, ret);
+    ret = 0;
   }
 
   return ret;
 }
 
 /**
-  * @brief  Interrupt active-high/low.[get]
+  * @brief  Submit the chunks of a request, looping as long as they
+  *         complete synchronously. A submission error of a later chunk
+  *         is reported to the caller through done.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of int_h_l in reg CTRL_REG3.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  req    Asynchronous request.(ptr)
+  * @param  first  1 when called from the submitting function, 0 when
+  *                called from the completion of a previous chunk
+  * @retval        Submission status of the first chunk
+  *                (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_int_polarity_get(const stmdev_ctx_t *ctx,
-                                 lps25hb_int_h_l_t *val)
+static int32_t lps25hb_async_run(lps25hb_async_t *req, uint8_t first)
 {
-  lps25hb_ctrl_reg3_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG3, (uint8_t *)&reg, 1);
+  do
+  {
+    req->state = LPS25HB_ASYNC_SUBMITTING;
+    ret = lps25hb_async_start(req);
 
-  if (ret != 0) { return ret; }
+    if (ret != 0)
+    {
+      req->state = LPS25HB_ASYNC_IDLE;
 
-  switch (reg.int_h_l)
-  {
-    case LPS25HB_ACTIVE_HIGH:
-      *val = LPS25HB_ACTIVE_HIGH;
-      break;
+      if (first != 0U) { return ret; }
 
-    case LPS25HB_ACTIVE_LOW:
-      *val = LPS25HB_ACTIVE_LOW;
-      break;
+      req->status = ret;
+      (void)lps25hb_async_step(req);
 
-    default:
-      *val = LPS25HB_ACTIVE_HIGH;
-      break;
-  }
+      return 0;
+    }
 
-  return ret;
+    first = 0;
+
+    if (LPS25HB_ASYNC_CAS(&req->state, LPS25HB_ASYNC_SUBMITTING,
+                          LPS25HB_ASYNC_IDLE))
+    {
+      /* in flight, lps25hb_async_complete goes on */
+      return 0;
+    }
+
+    req->state = LPS25HB_ASYNC_IDLE;
+  } while (lps25hb_async_step(req) != 0U);
+
+  return 0;
 }
 
 /**
-  * @brief  Data-ready signal on INT_DRDY pin.[set]
+  * @brief  Non-blocking version of lps25hb_data_get.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of drdy in reg CTRL_REG4
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  req    Request with done and arg set, valid until done.(ptr)
+  * @param  val    Structure that stores data read.(ptr)
+  * @retval        Submission status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_drdy_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lps25hb_data_get_async(const stmdev_ctx_t *ctx, lps25hb_async_t *req,
+                               lps25hb_data_t *val)
 {
-  lps25hb_ctrl_reg4_t reg;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
-
-  if (ret == 0)
+  if (ctx == NULL)
   {
-    reg.drdy = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+    return -1;
   }
 
+  req->ctx = ctx;
+  req->data = val;
+  req->sample = NULL;
+  req->num = 1;
+  req->idx = 0;
+  ret = lps25hb_async_run(req, 1);
+
   return ret;
 }
 
 /**
-  * @brief  Data-ready signal on INT_DRDY pin.[get]
+  * @brief  Non-blocking version of lps25hb_fifo_data_get. Samples are
+  *         read one burst at a time, each burst being submitted by the
+  *         completion of the previous one.[get]
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of drdy in reg CTRL_REG4.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  req    Request with done and arg set, valid until done.(ptr)
+  * @param  val    Buffer that stores the samples read.(ptr)
+  * @param  num    Number of samples to read
+  * @retval        Submission status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_drdy_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_data_get_async(const stmdev_ctx_t *ctx,
+                                    lps25hb_async_t *req,
+                                    lps25hb_fifo_sample_t *val, uint8_t num)
 {
-  lps25hb_ctrl_reg4_t reg;
-  int32_t ret;
+  int32_t ret = 0;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  if (ctx == NULL)
+  {
+    return -1;
+  }
 
-  if (ret != 0) { return ret; }
+  req->ctx = ctx;
+  req->data = NULL;
+  req->sample = val;
+  req->num = num;
+  req->idx = 0;
 
-  *val = reg.drdy;
+  if (num == 0U)
+  {
+    if (req->done != NULL)
+    {
+      req->done(req->arg, 0);
+    }
+  }
+  else
+  {
+    ret = lps25hb_async_run(req, 1);
+  }
 
   return ret;
 }
 
 /**
-  * @brief  FIFO overrun interrupt on INT_DRDY pin.[set]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of f_ovr in reg CTRL_REG4
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @}
   *
   */
-int32_t lps25hb_fifo_ovr_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
-{
-  lps25hb_ctrl_reg4_t reg;
-  int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+/**
+  * @defgroup   LPS25HB_fifo_stream
+  * @brief      This section group the functions that run a watermark
+  *             driven acquisition: the FIFO is set in stream mode with
+  *             the watermark signalled on INT_DRDY pin, and on each
+  *             interrupt the application calls lps25hb_fifo_stream_drain
+  *             which reads the stored samples and hands them to the
+  *             consumer callback.
+  * @{
+  *
+  */
 
-  if (ret == 0)
+/**
+  * @brief  Get the number of samples stored in FIFO.
+  *
+  * @param  status   FIFO_STATUS register
+  * @retval          number of unread samples
+  *
+  */
+static uint8_t lps25hb_fifo_stored(lps25hb_fifo_status_t status)
+{
+  if (status.empty_fifo != 0U)
   {
-    reg.f_ovr = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+    return 0;
   }
 
-  return ret;
+  /* FSS wraps to 0 when the 32 slots are all filled */
+  return (status.fss == 0U) ? (uint8_t)LPS25HB_FIFO_SIZE : status.fss;
 }
 
 /**
-  * @brief  FIFO overrun interrupt on INT_DRDY pin.[get]
+  * @brief  Enable FIFO in stream mode with the watermark level and route
+  *         the watermark flag on INT_DRDY pin.
+  *         FTH_FIFO is set while the unread samples (FSS) reach
+  *         WTM_POINT whatever the value of STOP_ON_FTH, which only
+  *         limits the FIFO depth to the watermark (see AN4672). The bit
+  *         is cleared, so the slots above the watermark keep the
+  *         samples produced until the drain starts.
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of f_ovr in reg CTRL_REG4.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  wtm    FIFO watermark level (see lps25hb_fifo_watermark_set)
+  * @retval        Interface status (MANDATORY: return 0 -> no Error),
+  *                -1 if wtm is out of range
   *
   */
-int32_t lps25hb_fifo_ovr_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_fifo_stream_start(const stmdev_ctx_t *ctx, uint8_t wtm)
 {
-  lps25hb_ctrl_reg4_t reg;
+  lps25hb_ctrl_reg2_t ctrl_reg2;
+  lps25hb_ctrl_reg3_t ctrl_reg3;
+  lps25hb_ctrl_reg4_t ctrl_reg4;
+  lps25hb_fifo_ctrl_t fifo_ctrl;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  /* wtm_point is 5 bits wide */
+  if (wtm >= LPS25HB_FIFO_SIZE)
+  {
+    return -1;
+  }
 
-  if (ret != 0) { return ret; }
+  lps25hb_lock(ctx);
 
-  *val = reg.f_ovr;
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2,
+                                (uint8_t *)&ctrl_reg2, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg2.fifo_en = PROPERTY_ENABLE;
+    ctrl_reg2.stop_on_fth = PROPERTY_DISABLE;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG2,
+                                   (uint8_t *)&ctrl_reg2, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps25hb_shadow_read_reg(ctx, LPS25HB_FIFO_CTRL,
+                                  (uint8_t *)&fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    fifo_ctrl.wtm_point = wtm;
+    fifo_ctrl.f_mode = (uint8_t)LPS25HB_STREAM_MODE;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_FIFO_CTRL,
+                                   (uint8_t *)&fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG3,
+                                  (uint8_t *)&ctrl_reg3, 1);
+  }
+
+  if (ret == 0)
+  {
+    ctrl_reg3.int_s = (uint8_t)LPS25HB_DRDY_OR_FIFO_FLAGS;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG3,
+                                   (uint8_t *)&ctrl_reg3, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4,
+                                  (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  if (ret == 0)
+  {
+    ctrl_reg4.f_fth = PROPERTY_ENABLE;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG4,
+                                   (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  lps25hb_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  FIFO watermark status on INT_DRDY pin.[set]
+  * @brief  Remove the watermark flag from INT_DRDY pin and set FIFO in
+  *         bypass mode.
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of f_fth in reg CTRL_REG4
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_fifo_threshold_on_int_set(const stmdev_ctx_t *ctx,
-                                          uint8_t val)
+int32_t lps25hb_fifo_stream_stop(const stmdev_ctx_t *ctx)
 {
-  lps25hb_ctrl_reg4_t reg;
+  lps25hb_ctrl_reg4_t ctrl_reg4;
+  lps25hb_fifo_ctrl_t fifo_ctrl;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG4,
+                                (uint8_t *)&ctrl_reg4, 1);
 
   if (ret == 0)
   {
-    reg.f_fth = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+    ctrl_reg4.f_fth = PROPERTY_DISABLE;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_CTRL_REG4,
+                                   (uint8_t *)&ctrl_reg4, 1);
+  }
+
+  if (ret == 0)
+  {
+    ret = lps25hb_shadow_read_reg(ctx, LPS25HB_FIFO_CTRL,
+                                  (uint8_t *)&fifo_ctrl, 1);
+  }
+
+  if (ret == 0)
+  {
+    fifo_ctrl.f_mode = (uint8_t)LPS25HB_BYPASS_MODE;
+    ret = lps25hb_shadow_write_reg(ctx, LPS25HB_FIFO_CTRL,
+                                   (uint8_t *)&fifo_ctrl, 1);
   }
 
+  lps25hb_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  FIFO watermark status on INT_DRDY pin.[get]
+  * @brief  Get the output data rate in tenth of Hz.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of f_fth in reg CTRL_REG4.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  odr    Output data rate
+  * @retval        Output data rate [0.1 Hz], 0 if not continuous
   *
   */
-int32_t lps25hb_fifo_threshold_on_int_get(const stmdev_ctx_t *ctx,
-                                          uint8_t *val)
+static uint32_t lps25hb_odr_to_dhz(uint8_t odr)
 {
-  lps25hb_ctrl_reg4_t reg;
-  int32_t ret;
+  uint32_t dhz;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  switch (odr)
+  {
+    case LPS25HB_ODR_1Hz:
+      dhz = 10U;
+      break;
 
-  if (ret != 0) { return ret; }
+    case LPS25HB_ODR_7Hz:
+      dhz = 70U;
+      break;
 
-  *val = reg.f_fth;
+    case LPS25HB_ODR_12Hz5:
+      dhz = 125U;
+      break;
 
-  return ret;
+    case LPS25HB_ODR_25Hz:
+      dhz = 250U;
+      break;
+
+    default:
+      dhz = 0U;
+      break;
+  }
+
+  return dhz;
 }
 
 /**
-  * @brief  FIFO empty flag on INT_DRDY pin.[set]
+  * @brief  Read STATUS_REG and FIFO_STATUS in one transaction.
+  *         INT_SOURCE is not read here, it would clear latched
+  *         interrupts.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of f_empty in reg CTRL_REG4
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ctx          Read / write interface definitions.(ptr)
+  * @param  status_reg   STATUS_REG.(ptr)
+  * @param  status       FIFO_STATUS.(ptr)
+  * @retval              Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_fifo_empty_on_int_set(const stmdev_ctx_t *ctx, uint8_t val)
+static int32_t lps25hb_fifo_status_read(const stmdev_ctx_t *ctx,
+                                        lps25hb_status_reg_t *status_reg,
+                                        lps25hb_fifo_status_t *status)
 {
-  lps25hb_ctrl_reg4_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+  lps25hb_seg_t seg[2];
 
-  if (ret == 0)
-  {
-    reg.f_empty = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
-  }
+  seg[0].reg = LPS25HB_STATUS_REG;
+  seg[0].data = (uint8_t *)status_reg;
+  seg[0].len = 1;
+  seg[1].reg = LPS25HB_FIFO_STATUS;
+  seg[1].data = (uint8_t *)status;
+  seg[1].len = 1;
 
-  return ret;
+  return lps25hb_read_multi_reg(ctx, seg, 2);
 }
 
 /**
-  * @brief  FIFO empty flag on INT_DRDY pin.[get]
+  * @brief  Check for FIFO overrun (FIFO_STATUS.ovr, STATUS_REG.p_or /
+  *         t_or).
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of f_empty in reg CTRL_REG4.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  status_reg   STATUS_REG.(ptr)
+  * @param  status       FIFO_STATUS.(ptr)
+  * @retval              1 on overrun, 0 otherwise
   *
   */
-int32_t lps25hb_fifo_empty_on_int_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static uint8_t lps25hb_fifo_overrun(const lps25hb_status_reg_t *status_reg,
+                                    const lps25hb_fifo_status_t *status)
 {
-  lps25hb_ctrl_reg4_t reg;
-  int32_t ret;
+  return ((status->ovr != 0U) || (status_reg->p_or != 0U) ||
+          (status_reg->t_or != 0U)) ? 1U : 0U;
+}
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG4, (uint8_t *)&reg, 1);
+/**
+  * @brief  Sample period used to estimate the samples lost in FIFO
+  *         overrun: the fitted one when ts is set, the nominal one of
+  *         the output data rate otherwise.
+  *
+  * @param  ctx      Read / write interface definitions.(ptr)
+  * @param  ts       Timestamp fit, NULL if not used.(ptr)
+  * @retval          Sample period [us], 0 if unknown
+  *
+  */
+static float_t lps25hb_fifo_period(const stmdev_ctx_t *ctx,
+                                   const lps25hb_ts_t *ts)
+{
+  lps25hb_ctrl_reg1_t ctrl_reg1;
+  float_t period = 0.0f;
+  uint32_t dhz;
 
-  if (ret != 0) { return ret; }
+  if (ts != NULL)
+  {
+    period = lps25hb_ts_period_get(ts);
+  }
+  else if (lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1,
+                                   (uint8_t *)&ctrl_reg1, 1) == 0)
+  {
+    dhz = lps25hb_odr_to_dhz(ctrl_reg1.odr);
 
-  *val = reg.f_empty;
+    if (dhz != 0U)
+    {
+      period = 1.0e7f / (float_t)dhz;
+    }
+  }
+  else
+  {
+    /* period unknown */
+  }
 
-  return ret;
+  return period;
 }
 
 /**
-  * @brief  Enable interrupt generation on pressure low/high event.[set]
+  * @brief  Estimate the samples lost in FIFO overrun: at least one,
+  *         more if the read came later than the FIFO depth allows.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of pe in reg INTERRUPT_CFG
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  period    Sample period [us], 0 if unknown
+  * @param  count     Samples read so far, 0 if none
+  * @param  elapsed   Host time since the previous read [us]
+  * @param  num       Samples stored in FIFO
+  * @retval           Samples lost
   *
   */
-int32_t lps25hb_sign_of_int_threshold_set(const stmdev_ctx_t *ctx,
-                                          lps25hb_pe_t val)
+static uint32_t lps25hb_fifo_lost(float_t period, uint32_t count,
+                                  uint32_t elapsed, uint8_t num)
 {
-  lps25hb_interrupt_cfg_t reg;
-  int32_t ret;
+  uint32_t expected;
+  uint32_t lost = 1;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
-
-  if (ret == 0)
+  if ((period > 0.0f) && (count != 0U))
   {
-    reg.pe = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
+    expected = (uint32_t)(((float_t)elapsed / period) + 0.5f);
+
+    if (expected > ((uint32_t)num + 1U))
+    {
+      lost = expected - num;
+    }
   }
 
-  return ret;
+  return lost;
 }
 
 /**
-  * @brief  Enable interrupt generation on pressure low/high event.[get]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of pe in reg INTERRUPT_CFG.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @brief  Read all the samples stored in FIFO and pass them to the
+  *         consumer callback. To be called on the watermark interrupt.
+  *         Samples are timestamped with ts when set, with the drain
+  *         time otherwise.
+  *         A FIFO overrun (FIFO_STATUS.ovr, STATUS_REG.p_or / t_or) is
+  *         reported to the consumer with a gap marker placed before the
+  *         samples: flags = LPS25HB_SAMPLE_GAP, pressure = number of
+  *         samples lost, estimated from the ODR and the time elapsed
+  *         since the previous drain.
+  *
+  * @param  ctx      Read / write interface definitions.(ptr)
+  * @param  stream   Stream with cb, arg and ts set.(ptr)
+  * @param  now      Host time of the drain [us]
+  * @retval          Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_sign_of_int_threshold_get(const stmdev_ctx_t *ctx,
-                                          lps25hb_pe_t *val)
+int32_t lps25hb_fifo_stream_drain(const stmdev_ctx_t *ctx,
+                                  lps25hb_fifo_stream_t *stream,
+                                  uint32_t now)
 {
-  lps25hb_interrupt_cfg_t reg;
+  lps25hb_sample_t *sample = &stream->buff[1];
+  float_t period = 0.0f;
+  uint32_t lost = 0;
+  uint8_t ovr = 0;
+  uint8_t num = 0;
+  uint8_t i;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
+  lps25hb_lock(ctx);
+  ret = lps25hb_fifo_status_read(ctx, &stream->status_reg,
+                                 &stream->status);
 
-  if (ret != 0) { return ret; }
+  if (ret == 0)
+  {
+    num = lps25hb_fifo_stored(stream->status);
+  }
 
-  switch (reg.pe)
+  /* decoded in place, after the room left for the gap marker */
+  for (i = 0; (i < num) && (ret == 0); i++)
   {
-    case LPS25HB_NO_THRESHOLD:
-      *val = LPS25HB_NO_THRESHOLD;
-      break;
+    ret = lps25hb_fifo_sample_read(ctx, &sample[i].pressure,
+                                   &sample[i].temperature);
+  }
 
-    case LPS25HB_POSITIVE:
-      *val = LPS25HB_POSITIVE;
-      break;
+  if ((ret == 0) &&
+      (lps25hb_fifo_overrun(&stream->status_reg, &stream->status) != 0U))
+  {
+    ovr = 1;
+    period = lps25hb_fifo_period(ctx, stream->ts);
+  }
 
-    case LPS25HB_NEGATIVE:
-      *val = LPS25HB_NEGATIVE;
-      break;
+  lps25hb_unlock(ctx);
 
-    case LPS25HB_BOTH:
-      *val = LPS25HB_BOTH;
-      break;
+  if ((ret != 0) || (num == 0U)) { return ret; }
 
-    default:
-      *val = LPS25HB_NO_THRESHOLD;
-      break;
+  if (ovr != 0U)
+  {
+    lost = lps25hb_fifo_lost(period, stream->count, now - stream->last,
+                             num);
+    stream->lost += lost;
+    stream->overrun++;
+
+    if (stream->ts != NULL)
+    {
+      lps25hb_ts_skip(stream->ts, lost);
+    }
+  }
+
+  for (i = 0; i < num; i++)
+  {
+    sample[i].flags = 0;
+    sample[i].timestamp = now;
+  }
+
+  if (stream->ts != NULL)
+  {
+    lps25hb_ts_update(stream->ts, now, sample, num);
+  }
+
+  stream->count += num;
+  stream->last = now;
+
+  if (lost != 0U)
+  {
+    /* marker timestamped with the first sample lost */
+    sample = &stream->buff[0];
+    sample->pressure = lost;
+    sample->temperature = 0;
+    sample->flags = LPS25HB_SAMPLE_GAP;
+    sample->timestamp = stream->buff[1].timestamp -
+                        (uint32_t)((float_t)lost * period);
+    num++;
+  }
+
+  if (stream->cb != NULL)
+  {
+    stream->cb(stream->arg, sample, num);
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup   LPS25HB_ring
+  * @brief      This section group the functions of the lock-free sample
+  *             ring used to pass samples from the interrupt / bus
+  *             completion context (producer) to a processing thread
+  *             (consumer). Indexes are free running and each one is
+  *             written by one side only, so no lock is needed.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Initialize the ring on a caller-provided buffer. The ring
+  *         must be aligned to LPS25HB_CACHE_LINE, see lps25hb_ring_t.
+  *
+  * @param  ring   Sample ring.(ptr)
+  * @param  buff   Sample storage.(ptr)
+  * @param  size   Number of samples in buff, power of 2
+  * @retval        0 -> no Error, -1 if size is not a power of 2
+  *
+  */
+int32_t lps25hb_ring_init(lps25hb_ring_t *ring, lps25hb_sample_t *buff,
+                          uint32_t size)
+{
+  if ((size == 0U) || ((size & (size - 1U)) != 0U))
+  {
+    return -1;
   }
 
-  return ret;
+  ring->head = 0;
+  ring->dropped = 0;
+  ring->gap = 0;
+  ring->tail = 0;
+  ring->buff = buff;
+  ring->mask = size - 1U;
+
+  return 0;
 }
 
 /**
-  * @brief  Interrupt request to the INT_SOURCE (25h) register mode.[set]
+  * @brief  Push samples in the ring (producer side). Samples not fitting
+  *         are counted in ring->dropped, and the next sample pushed is
+  *         flagged LPS25HB_SAMPLE_AFTER_GAP.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of lir in reg INTERRUPT_CFG
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ring   Sample ring.(ptr)
+  * @param  val    Samples to push.(ptr)
+  * @param  num    Number of samples to push
+  * @retval        Number of samples pushed, less than num if ring is full
   *
   */
-int32_t lps25hb_int_notification_mode_set(const stmdev_ctx_t *ctx,
-                                          lps25hb_lir_t val)
+uint32_t lps25hb_ring_push(lps25hb_ring_t *ring, const lps25hb_sample_t *val,
+                           uint32_t num)
 {
-  lps25hb_interrupt_cfg_t reg;
-  int32_t ret;
+  uint32_t head = ring->head;
+  uint32_t free_num;
+  uint8_t gap = 0;
+  uint32_t i;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
+  LPS25HB_MEM_BARRIER();
+  free_num = ring->mask + 1U - (head - ring->tail);
 
-  if (ret == 0)
+  if (num > free_num)
   {
-    reg.lir = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
+    ring->dropped += num - free_num;
+    num = free_num;
+    gap = 1;
   }
 
-  return ret;
+  for (i = 0; i < num; i++)
+  {
+    ring->buff[(head + i) & ring->mask] = val[i];
+  }
+
+  if ((num != 0U) && (ring->gap != 0U))
+  {
+    ring->buff[head & ring->mask].flags |= (uint8_t)LPS25HB_SAMPLE_AFTER_GAP;
+    ring->gap = 0;
+  }
+
+  if (gap != 0U)
+  {
+    ring->gap = 1;
+  }
+
+  LPS25HB_MEM_BARRIER();
+  ring->head = head + num;
+
+  return num;
 }
 
 /**
-  * @brief  Interrupt request to the  INT_SOURCE (25h) register mode.[get]
+  * @brief  Pop samples from the ring (consumer side).
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of lir in reg INTERRUPT_CFG.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ring   Sample ring.(ptr)
+  * @param  val    Buffer that stores the samples popped.(ptr)
+  * @param  num    Maximum number of samples to pop
+  * @retval        Number of samples popped
   *
   */
-int32_t lps25hb_int_notification_mode_get(const stmdev_ctx_t *ctx,
-                                          lps25hb_lir_t *val)
+uint32_t lps25hb_ring_pop(lps25hb_ring_t *ring, lps25hb_sample_t *val,
+                          uint32_t num)
 {
-  lps25hb_interrupt_cfg_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_INTERRUPT_CFG, (uint8_t *)&reg, 1);
+  uint32_t tail = ring->tail;
+  uint32_t used;
+  uint32_t i;
 
-  if (ret != 0) { return ret; }
+  LPS25HB_MEM_BARRIER();
+  used = ring->head - tail;
 
-  switch (reg.lir)
+  if (num > used)
   {
-    case LPS25HB_INT_PULSED:
-      *val = LPS25HB_INT_PULSED;
-      break;
+    num = used;
+  }
 
-    case LPS25HB_INT_LATCHED:
-      *val = LPS25HB_INT_LATCHED;
-      break;
+  LPS25HB_MEM_BARRIER();
 
-    default:
-      *val = LPS25HB_INT_PULSED;
-      break;
+  for (i = 0; i < num; i++)
+  {
+    val[i] = ring->buff[(tail + i) & ring->mask];
   }
 
-  return ret;
+  LPS25HB_MEM_BARRIER();
+  ring->tail = tail + num;
+
+  return num;
 }
 
 /**
-  * @brief  Interrupt source register[get]
+  * @brief  Stream consumer that pushes the drained FIFO samples in the
+  *         ring passed as stream argument. Samples not fitting in the
+  *         ring are discarded and accounted, see lps25hb_ring_push.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get registers INT_SOURCE.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ring   Sample ring (lps25hb_ring_t).(ptr)
+  * @param  val    Samples drained from FIFO.(ptr)
+  * @param  num    Number of samples
   *
   */
-int32_t lps25hb_int_source_get(const stmdev_ctx_t *ctx,
-                               lps25hb_int_source_t *val)
+void lps25hb_ring_stream_cb(void *ring, const lps25hb_sample_t *val,
+                            uint8_t num)
 {
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *) val, 1);
-
-  return ret;
+  (void)lps25hb_ring_push((lps25hb_ring_t *)ring, val, num);
 }
 
 /**
-  * @brief  Differential pressure high interrupt flag.[get]
+  * @}
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of ph in reg INT_SOURCE.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  */
+
+/**
+  * @defgroup   LPS25HB_fifo_wtm_ctrl
+  * @brief      This section group the functions that retune the FIFO
+  *             watermark at runtime: the watermark is the highest level
+  *             reached within the latency budget that still leaves room
+  *             in FIFO for the samples produced while draining it.
+  * @{
   *
   */
-int32_t lps25hb_int_on_press_high_get(const stmdev_ctx_t *ctx, uint8_t *val)
+
+#define LPS25HB_WTM_MARGIN_MAX      8U
+#define LPS25HB_WTM_MARGIN_DECAY    16U
+
+/**
+  * @brief  Retune the FIFO watermark. To be called after each drain
+  *         with the measured time between the watermark event and the
+  *         end of the drain. An overrun raises the free margin by one
+  *         slot, which is released again after a series of drains
+  *         without overrun. WTM_POINT is written only when changed,
+  *         as level - 1.
+  *         The slots above the watermark hold the samples produced
+  *         while draining, as set by lps25hb_fifo_stream_start. With
+  *         STOP_ON_FTH set there are none: an overrun then depends only
+  *         on the interrupt latency, which the level cannot change, so
+  *         the level follows the latency budget and the overrun margin
+  *         is left untouched.
+  *
+  * @param  ctx        Read / write interface definitions.(ptr)
+  * @param  val        Controller state, latency_ms set by caller.(ptr)
+  * @param  status     FIFO_STATUS read at drain time, NULL to read
+  *                    the overrun flag from the device.(ptr)
+  * @param  drain_ms   Measured drain latency [ms]
+  * @retval            Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t lps25hb_fifo_wtm_ctrl_update(const stmdev_ctx_t *ctx,
+                                     lps25hb_fifo_wtm_ctrl_t *val,
+                                     const lps25hb_fifo_status_t *status,
+                                     uint32_t drain_ms)
 {
-  lps25hb_int_source_t reg;
+  lps25hb_ctrl_reg1_t ctrl_reg1;
+  lps25hb_ctrl_reg2_t ctrl_reg2;
+  uint32_t budget;
+  uint32_t room;
+  uint32_t dhz = 0;
+  uint8_t ovr = 0;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *)&reg, 1);
+  /* ODR and watermark read and set as one operation */
+  lps25hb_lock(ctx);
 
-  if (ret != 0) { return ret; }
+  ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG1,
+                                (uint8_t *)&ctrl_reg1, 1);
 
-  *val = reg.ph;
+  if (ret == 0)
+  {
+    ret = lps25hb_shadow_read_reg(ctx, LPS25HB_CTRL_REG2,
+                                  (uint8_t *)&ctrl_reg2, 1);
+  }
+
+  if ((ret == 0) && (ctrl_reg2.stop_on_fth == PROPERTY_DISABLE))
+  {
+    if (status != NULL)
+    {
+      ovr = status->ovr;
+    }
+    else
+    {
+      ret = lps25hb_fifo_ovr_flag_get(ctx, &ovr);
+    }
+  }
+
+  if (ret == 0)
+  {
+    dhz = lps25hb_odr_to_dhz(ctrl_reg1.odr);
+  }
+
+  if ((dhz != 0U) && (ctrl_reg2.stop_on_fth == PROPERTY_DISABLE))
+  {
+    if (ovr != 0U)
+    {
+      val->overrun++;
+      val->clean = 0;
+
+      if (val->margin < LPS25HB_WTM_MARGIN_MAX)
+      {
+        val->margin++;
+      }
+    }
+    else if (val->margin > 0U)
+    {
+      val->clean++;
+
+      if (val->clean >= LPS25HB_WTM_MARGIN_DECAY)
+      {
+        val->margin--;
+        val->clean = 0;
+      }
+    }
+    else
+    {
+      /* no margin to release */
+    }
+  }
+
+  if (dhz != 0U)
+  {
+    /* samples produced within the latency budget */
+    budget = (val->latency_ms * dhz) / 10000U;
+
+    if (ctrl_reg2.stop_on_fth == PROPERTY_DISABLE)
+    {
+      /* free slots needed while draining: round up plus one in flight */
+      room = ((drain_ms * dhz) + 9999U) / 10000U + 1U + val->margin;
+      room = (room < LPS25HB_FIFO_SIZE) ? (LPS25HB_FIFO_SIZE - room) : 1U;
+    }
+    else
+    {
+      /* FIFO stops at the watermark, no slot above it */
+      room = LPS25HB_FIFO_SIZE;
+    }
+
+    if (budget > room)
+    {
+      budget = room;
+    }
+
+    if (budget == 0U)
+    {
+      budget = 1U;
+    }
+
+    if (budget != val->level)
+    {
+      ret = lps25hb_fifo_watermark_set(ctx, (uint8_t)(budget - 1U));
+
+      if (ret == 0)
+      {
+        val->level = (uint8_t)budget;
+      }
+    }
+  }
+
+  lps25hb_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  Differential pressure low interrupt flag.[get]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of pl in reg INT_SOURCE.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @}
   *
   */
-int32_t lps25hb_int_on_press_low_get(const stmdev_ctx_t *ctx, uint8_t *val)
-{
-  lps25hb_int_source_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
 
-  *val = reg.pl;
+/**
+  * @defgroup   LPS25HB_timestamp
+  * @brief      This section group the functions that timestamp the
+  *             samples drained from FIFO. Each drain adds a point (total
+  *             samples read, host time) to a running linear regression
+  *             with exponential forgetting: its slope is the sample
+  *             period measured with the host clock, which gives the
+  *             sensor oscillator drift, and the samples of a batch are
+  *             spaced by this period back from the fitted drain time.
+  * @{
+  *
+  */
 
-  return ret;
-}
+#define LPS25HB_TS_FORGET       0.98f
+#define LPS25HB_TS_TOLERANCE    0.1f
 
 /**
-  * @brief  Interrupt active flag.[get]
+  * @brief  Initialize the timestamping for an output data rate.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of ia in reg INT_SOURCE
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  val    Timestamping state.(ptr)
+  * @param  odr    Output data rate in use
+  * @retval        0 -> no Error, -1 if odr is not a continuous mode
   *
   */
-int32_t lps25hb_interrupt_event_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_ts_init(lps25hb_ts_t *val, lps25hb_odr_t odr)
 {
-  lps25hb_int_source_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_INT_SOURCE, (uint8_t *)&reg, 1);
+  uint32_t dhz = lps25hb_odr_to_dhz((uint8_t)odr);
 
-  if (ret != 0) { return ret; }
+  if (dhz == 0U)
+  {
+    return -1;
+  }
 
-  *val = reg.ia;
+  val->period = 1.0e7f / (float_t)dhz;
+  val->w = 0.0f;
+  val->mx = 0.0f;
+  val->my = 0.0f;
+  val->cxx = 0.0f;
+  val->cxy = 0.0f;
+  val->last = 0;
 
-  return ret;
+  return 0;
 }
 
 /**
-  * @brief  User-defined threshold value for pressure interrupt event[set]
+  * @brief  Get the sample period fitted by the regression.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that contains data to write
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  val      Timestamping state.(ptr)
+  * @param  period   Fitted sample period [us].(ptr)
+  * @retval          1 if enough drains were seen and the fit is within
+  *                  the oscillator tolerance, 0 otherwise
   *
   */
-int32_t lps25hb_int_threshold_set(const stmdev_ctx_t *ctx, uint16_t val)
+static uint8_t lps25hb_ts_fit(const lps25hb_ts_t *val, float_t *period)
 {
-  uint8_t buff[2];
-  int32_t ret;
+  if ((val->w < 2.0f) || (val->cxx <= 0.0f))
+  {
+    return 0;
+  }
 
-  buff[1] = (uint8_t)(val / 256U);
-  buff[0] = (uint8_t)(val - (buff[1] * 256U));
-  ret = lps25hb_read_reg(ctx, LPS25HB_THS_P_L,  buff, 2);
+  *period = val->cxy / val->cxx;
 
-  return ret;
+  if ((*period < (val->period * (1.0f - LPS25HB_TS_TOLERANCE))) ||
+      (*period > (val->period * (1.0f + LPS25HB_TS_TOLERANCE))))
+  {
+    return 0;
+  }
+
+  return 1;
 }
 
 /**
-  * @brief  User-defined threshold value for pressure interrupt event[get]
+  * @brief  Estimated sample period. The nominal one is returned until
+  *         enough drains are seen or if the estimate is out of the
+  *         oscillator tolerance.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  buff   Buffer that stores data read.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  val    Timestamping state.(ptr)
+  * @retval        Sample period measured with the host clock [us]
   *
   */
-int32_t lps25hb_int_threshold_get(const stmdev_ctx_t *ctx, uint16_t *val)
+float_t lps25hb_ts_period_get(const lps25hb_ts_t *val)
 {
-  uint8_t buff[2];
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_THS_P_L,  buff, 2);
-
-  if (ret != 0) { return ret; }
+  float_t period;
 
-  *val = buff[1];
-  *val = (*val * 256) + buff[0];
+  if (lps25hb_ts_fit(val, &period) == 0U)
+  {
+    period = val->period;
+  }
 
-  return ret;
+  return period;
 }
 
 /**
-  * @}
+  * @brief  Estimated drift of the sensor oscillator against host clock.
   *
-  */
-
-/**
-  * @defgroup   LPS25HB_fifo
-  * @brief   This section group all the functions concerning the fifo usage
-  * @{
+  * @param  val    Timestamping state.(ptr)
+  * @retval        Drift [ppm], positive if the sensor is slower
   *
   */
+float_t lps25hb_ts_drift_get(const lps25hb_ts_t *val)
+{
+  return ((lps25hb_ts_period_get(val) / val->period) - 1.0f) * 1.0e6f;
+}
 
 /**
-  * @brief  Stop on FIFO watermark. Enable FIFO watermark level use.[set]
+  * @brief  Account samples lost in FIFO overrun, so that the sample
+  *         count of the regression stays continuous.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of stop_on_fth in reg CTRL_REG2
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  val    Timestamping state.(ptr)
+  * @param  num    Number of samples lost
   *
   */
-int32_t lps25hb_stop_on_fifo_threshold_set(const stmdev_ctx_t *ctx,
-                                           uint8_t val)
+void lps25hb_ts_skip(lps25hb_ts_t *val, uint32_t num)
 {
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
-
-  if (ret == 0)
+  if (val->w > 0.0f)
   {
-    reg.stop_on_fth = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    val->mx -= (float_t)num;
   }
-
-  return ret;
 }
 
 /**
-  * @brief  Stop on FIFO watermark. Enable FIFO watermark level use.[get]
+  * @brief  Add a drain to the regression and timestamp its samples, the
+  *         last one being the most recent. Lost samples (FIFO overrun)
+  *         must be accounted with lps25hb_ts_skip before.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of stop_on_fth in reg CTRL_REG2.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  val      Timestamping state.(ptr)
+  * @param  now      Host time of the drain [us]
+  * @param  sample   Samples of the drain, oldest first.(ptr)
+  * @param  num      Number of samples
   *
   */
-int32_t lps25hb_stop_on_fifo_threshold_get(const stmdev_ctx_t *ctx,
-                                           uint8_t *val)
+void lps25hb_ts_update(lps25hb_ts_t *val, uint32_t now,
+                       lps25hb_sample_t *sample, uint8_t num)
 {
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
+  float_t period;
+  float_t origin;
+  float_t offset;
+  float_t dx;
+  uint8_t i;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  if (num == 0U)
+  {
+    return;
+  }
 
-  if (ret != 0) { return ret; }
+  if (val->w > 0.0f)
+  {
+    /* move the origin to the new point (num samples, now) */
+    val->mx -= (float_t)num;
+    val->my -= (float_t)(now - val->last);
+  }
 
-  *val = reg.stop_on_fth;
+  val->last = now;
+  val->w = (LPS25HB_TS_FORGET * val->w) + 1.0f;
+  dx = -val->mx;
+  val->mx += dx / val->w;
+  val->my += -val->my / val->w;
+  val->cxx = (LPS25HB_TS_FORGET * val->cxx) + (dx * -val->mx);
+  val->cxy = (LPS25HB_TS_FORGET * val->cxy) + (dx * -val->my);
 
-  return ret;
+  if (lps25hb_ts_fit(val, &period) != 0U)
+  {
+    /* fitted time of the last sample, relative to now */
+    origin = val->my - (period * val->mx);
+  }
+  else
+  {
+    period = val->period;
+    origin = 0.0f;
+  }
+
+  for (i = 0; i < num; i++)
+  {
+    offset = origin - ((float_t)(num - 1U - i) * period);
+    sample[i].timestamp = now + (uint32_t)(int32_t)offset;
+  }
 }
 
 /**
-  * @brief  FIFOenable.[set]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of fifo_en in reg CTRL_REG2
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @}
   *
   */
-int32_t lps25hb_fifo_set(const stmdev_ctx_t *ctx, uint8_t val)
-{
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+/**
+  * @defgroup   LPS25HB_soa
+  * @brief      This section group the functions of the structure-of-arrays
+  *             sample buffer: each field is stored in its own array, so
+  *             that the batch conversion functions and the application
+  *             filters run on contiguous data. Arrays are provided by the
+  *             caller, aligned as required by the target vector unit, and
+  *             no allocation is done.
+  * @{
+  *
+  */
 
-  if (ret == 0)
+/**
+  * @brief  Initialize the buffer on caller-provided arrays.
+  *
+  * @param  buf          Sample buffer.(ptr)
+  * @param  pressure     Pressure array.(ptr)
+  * @param  temperature  Temperature array.(ptr)
+  * @param  timestamp    Timestamp array, NULL if not needed.(ptr)
+  * @param  flags        Flags array, NULL if not needed.(ptr)
+  * @param  size         Number of samples of each array
+  * @retval              0 -> no Error, -1 if an array is missing
+  *
+  */
+int32_t lps25hb_soa_init(lps25hb_soa_t *buf, uint32_t *pressure,
+                         int16_t *temperature, uint32_t *timestamp,
+                         uint8_t *flags, uint32_t size)
+{
+  if ((pressure == NULL) || (temperature == NULL) || (size == 0U))
   {
-    reg.fifo_en = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    return -1;
   }
 
-  return ret;
+  buf->pressure = pressure;
+  buf->temperature = temperature;
+  buf->timestamp = timestamp;
+  buf->flags = flags;
+  buf->size = size;
+  buf->len = 0;
+  buf->dropped = 0;
+  buf->gap = 0;
+  buf->count = 0;
+  buf->lost = 0;
+  buf->overrun = 0;
+  buf->last = 0;
+
+  return 0;
 }
 
 /**
-  * @brief  FIFOenable.[get]
+  * @brief  Empty the buffer.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of fifo_en in reg CTRL_REG2.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  buf    Sample buffer.(ptr)
   *
   */
-int32_t lps25hb_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val)
+void lps25hb_soa_clear(lps25hb_soa_t *buf)
 {
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = reg.fifo_en;
-
-  return ret;
+  buf->len = 0;
 }
 
 /**
-  * @brief  FIFO watermark level selection.[set]
+  * @brief  Drop the oldest samples, once processed, and move the others
+  *         to the beginning of the arrays.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of wtm_point in reg FIFO_CTRL
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  buf    Sample buffer.(ptr)
+  * @param  num    Number of samples to drop
   *
   */
-int32_t lps25hb_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
+void lps25hb_soa_discard(lps25hb_soa_t *buf, uint32_t num)
 {
-  lps25hb_fifo_ctrl_t reg;
-  int32_t ret;
+  uint32_t i;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
+  if (num >= buf->len)
+  {
+    buf->len = 0;
+    return;
+  }
 
-  if (ret == 0)
+  buf->len -= num;
+
+  for (i = 0; i < buf->len; i++)
   {
-    reg.wtm_point = val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
+    buf->pressure[i] = buf->pressure[i + num];
+    buf->temperature[i] = buf->temperature[i + num];
   }
 
-  return ret;
+  if (buf->timestamp != NULL)
+  {
+    for (i = 0; i < buf->len; i++)
+    {
+      buf->timestamp[i] = buf->timestamp[i + num];
+    }
+  }
+
+  if (buf->flags != NULL)
+  {
+    for (i = 0; i < buf->len; i++)
+    {
+      buf->flags[i] = buf->flags[i + num];
+    }
+  }
 }
 
 /**
-  * @brief  FIFO watermark level selection.[get]
+  * @brief  Append samples. A gap marker (LPS25HB_SAMPLE_GAP) is not
+  *         stored: its count is added to buf->lost and the next sample
+  *         stored, in this call or in a later one, is flagged
+  *         LPS25HB_SAMPLE_AFTER_GAP.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of wtm_point in reg FIFO_CTRL.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  buf    Sample buffer.(ptr)
+  * @param  val    Samples to append.(ptr)
+  * @param  num    Number of samples
+  * @retval        Number of entries of val consumed, less than num if
+  *                the buffer is full
   *
   */
-int32_t lps25hb_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
+uint32_t lps25hb_soa_append(lps25hb_soa_t *buf, const lps25hb_sample_t *val,
+                            uint32_t num)
 {
-  lps25hb_fifo_ctrl_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
+  uint32_t i;
 
-  if (ret != 0) { return ret; }
-
-  *val = reg.wtm_point;
+  for (i = 0; i < num; i++)
+  {
+    if ((val[i].flags & LPS25HB_SAMPLE_GAP) != 0U)
+    {
+      buf->lost += val[i].pressure;
+      buf->gap = 1;
+    }
+    else if (buf->len < buf->size)
+    {
+      buf->pressure[buf->len] = val[i].pressure;
+      buf->temperature[buf->len] = val[i].temperature;
+
+      if (buf->timestamp != NULL)
+      {
+        buf->timestamp[buf->len] = val[i].timestamp;
+      }
+
+      if (buf->flags != NULL)
+      {
+        buf->flags[buf->len] = (buf->gap != 0U) ?
+                               LPS25HB_SAMPLE_AFTER_GAP : 0U;
+      }
+
+      buf->gap = 0;
+      buf->len++;
+    }
+    else
+    {
+      break;
+    }
+  }
 
-  return ret;
+  return i;
 }
 
 /**
-  * @brief  FIFO mode selection.[set]
+  * @brief  Stream consumer that appends the drained FIFO samples to the
+  *         buffer passed as stream argument. Samples not fitting in the
+  *         buffer are counted in buf->dropped, and the next sample
+  *         stored is flagged LPS25HB_SAMPLE_AFTER_GAP.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of f_mode in reg FIFO_CTRL
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  buf    Sample buffer (lps25hb_soa_t).(ptr)
+  * @param  val    Samples drained from FIFO.(ptr)
+  * @param  num    Number of samples
   *
   */
-int32_t lps25hb_fifo_mode_set(const stmdev_ctx_t *ctx, lps25hb_f_mode_t val)
+void lps25hb_soa_stream_cb(void *buf, const lps25hb_sample_t *val,
+                           uint8_t num)
 {
-  lps25hb_fifo_ctrl_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
+  lps25hb_soa_t *soa = (lps25hb_soa_t *)buf;
+  uint32_t i;
 
-  if (ret == 0)
+  for (i = lps25hb_soa_append(soa, val, num); i < num; i++)
   {
-    reg.f_mode = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
+    if ((val[i].flags & LPS25HB_SAMPLE_GAP) == 0U)
+    {
+      soa->dropped++;
+      soa->gap = 1;
+    }
   }
-
-  return ret;
 }
 
 /**
-  * @brief  FIFO mode selection.[get]
+  * @brief  Read the samples stored in FIFO straight into the buffer,
+  *         up to its free space; the others are left in FIFO. Samples
+  *         are timestamped with now.
+  *         A FIFO overrun is handled as in lps25hb_fifo_stream_drain:
+  *         the samples lost, estimated from the ODR and the time elapsed
+  *         since the previous read, are added to buf->lost and the first
+  *         sample read is flagged LPS25HB_SAMPLE_AFTER_GAP.
   *
   * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of f_mode in reg FIFO_CTRL.(ptr)
+  * @param  buf    Sample buffer.(ptr)
+  * @param  now    Host time of the read [us]
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_fifo_mode_get(const stmdev_ctx_t *ctx,
-                              lps25hb_f_mode_t *val)
+int32_t lps25hb_soa_fifo_fill(const stmdev_ctx_t *ctx, lps25hb_soa_t *buf,
+                              uint32_t now)
 {
-  lps25hb_fifo_ctrl_t reg;
+  lps25hb_status_reg_t status_reg;
+  lps25hb_fifo_status_t status;
+  float_t period = 0.0f;
+  uint32_t num = 0;
+  uint32_t i;
+  uint8_t stored = 0;
+  uint8_t ovr = 0;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_CTRL, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
+  lps25hb_lock(ctx);
+  ret = lps25hb_fifo_status_read(ctx, &status_reg, &status);
 
-  switch (reg.f_mode)
+  if (ret == 0)
   {
-    case LPS25HB_BYPASS_MODE:
-      *val = LPS25HB_BYPASS_MODE;
-      break;
-
-    case LPS25HB_FIFO_MODE:
-      *val = LPS25HB_FIFO_MODE;
-      break;
+    stored = lps25hb_fifo_stored(status);
+    num = stored;
 
-    case LPS25HB_STREAM_MODE:
-      *val = LPS25HB_STREAM_MODE;
-      break;
+    if (num > (buf->size - buf->len))
+    {
+      num = buf->size - buf->len;
+    }
+  }
 
-    case LPS25HB_Stream_to_FIFO_mode:
-      *val = LPS25HB_Stream_to_FIFO_mode;
-      break;
+  if ((ret == 0) && (num != 0U) &&
+      (lps25hb_fifo_overrun(&status_reg, &status) != 0U))
+  {
+    ovr = 1;
+    buf->gap = 1;
+    period = lps25hb_fifo_period(ctx, NULL);
+  }
 
-    case LPS25HB_BYPASS_TO_STREAM_MODE:
-      *val = LPS25HB_BYPASS_TO_STREAM_MODE;
-      break;
+  for (i = 0; (i < num) && (ret == 0); i++)
+  {
+    ret = lps25hb_fifo_sample_read(ctx, &buf->pressure[buf->len],
+                                   &buf->temperature[buf->len]);
+
+    if (ret == 0)
+    {
+      if (buf->timestamp != NULL)
+      {
+        buf->timestamp[buf->len] = now;
+      }
+
+      if (buf->flags != NULL)
+      {
+        buf->flags[buf->len] = (buf->gap != 0U) ?
+                               LPS25HB_SAMPLE_AFTER_GAP : 0U;
+      }
+
+      buf->gap = 0;
+      buf->len++;
+    }
+  }
 
-    case LPS25HB_MEAN_MODE:
-      *val = LPS25HB_MEAN_MODE;
-      break;
+  lps25hb_unlock(ctx);
 
-    case LPS25HB_BYPASS_TO_FIFO_MODE:
-      *val = LPS25HB_BYPASS_TO_FIFO_MODE;
-      break;
+  if ((ret != 0) || (num == 0U)) { return ret; }
 
-    default:
-      *val = LPS25HB_BYPASS_MODE;
-      break;
+  if (ovr != 0U)
+  {
+    buf->lost += lps25hb_fifo_lost(period, buf->count, now - buf->last,
+                                   stored);
+    buf->overrun++;
   }
 
+  buf->count += num;
+  buf->last = now;
+
   return ret;
 }
 
 /**
-  * @brief  FIFO status register. [get]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  lps25hb_: registers FIFO_STATUS.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @}
   *
   */
-int32_t lps25hb_fifo_status_get(const stmdev_ctx_t *ctx,
-                                lps25hb_fifo_status_t *val)
-{
-  int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *) val, 1);
+/**
+  * @defgroup   LPS25HB_mgr
+  * @brief      This section group the functions that manage many sensors
+  *             spread on several buses (two per I2C bus at most, with
+  *             LPS25HB_I2C_ADD_L and LPS25HB_I2C_ADD_H). Sensors are
+  *             drained in round-robin per bus by lps25hb_mgr_service,
+  *             which must be called from a single context for each bus:
+  *             transfers of a bus are then serialized without locks,
+  *             while different buses can be served concurrently.
+  *             Alternatively any number of worker threads can call
+  *             lps25hb_mgr_service_any, that claims a ready bus for the
+  *             time of one drain.
+  *             Samples of all the sensors are passed to one consumer,
+  *             tagged with the sensor id.
+  * @{
+  *
+  */
 
-  return ret;
-}
+/*
+ * Atomic test-and-set of a bus claim, true if claimed by the caller.
+ * Without LPS25HB_SYNC_BUILTINS they must be defined to run more than
+ * one worker.
+ */
+#ifndef LPS25HB_MGR_CLAIM
+#if (LPS25HB_SYNC_BUILTINS == 1)
+#define LPS25HB_MGR_CLAIM(flag)   (__sync_lock_test_and_set(&(flag), 1U) == 0U)
+#define LPS25HB_MGR_RELEASE(flag) __sync_lock_release(&(flag))
+#else
+#define LPS25HB_MGR_CLAIM(flag)   ((flag) == 0U)
+#define LPS25HB_MGR_RELEASE(flag)
+#endif /* LPS25HB_SYNC_BUILTINS */
+#endif /* LPS25HB_MGR_CLAIM */
 
 /**
-  * @brief  FIFO stored data level.[get]
+  * @brief  Stream consumer of a managed sensor: tags the samples with
+  *         the sensor id and passes them to the manager consumer.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of fss in reg FIFO_STATUS.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  node   Managed sensor (lps25hb_mgr_node_t).(ptr)
+  * @param  val    Samples drained from FIFO.(ptr)
+  * @param  num    Number of samples
   *
   */
-int32_t lps25hb_fifo_data_level_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static void lps25hb_mgr_stream_cb(void *node, const lps25hb_sample_t *val,
+                                  uint8_t num)
 {
-  lps25hb_fifo_status_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
+  const lps25hb_mgr_node_t *sensor = (const lps25hb_mgr_node_t *)node;
+  const lps25hb_mgr_t *mgr = sensor->mgr;
 
-  if (ret != 0) { return ret; }
-
-  *val = reg.fss;
-
-  return ret;
+  if (mgr->cb != NULL)
+  {
+    mgr->cb(mgr->arg, sensor->id, val, num);
+  }
 }
 
 /**
-  * @brief  Empty FIFO status flag.[get]
+  * @brief  Initialize the manager on a caller-provided sensor table.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of empty_fifo in reg FIFO_STATUS.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  mgr    Manager.(ptr)
+  * @param  node   Sensor table.(ptr)
+  * @param  size   Number of entries of node
+  * @param  mode   Drain on notification or by polling
+  * @param  cb     Consumer of the samples of all the sensors. Buses
+  *                served from different contexts call it concurrently,
+  *                so it must be thread-safe and reentrant.
+  * @param  arg    Consumer argument.(ptr)
   *
   */
-int32_t lps25hb_fifo_empty_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+void lps25hb_mgr_init(lps25hb_mgr_t *mgr, lps25hb_mgr_node_t *node,
+                      uint16_t size, lps25hb_mgr_mode_t mode,
+                      lps25hb_mgr_ptr cb, void *arg)
 {
-  lps25hb_fifo_status_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
+  uint8_t i;
 
-  if (ret != 0) { return ret; }
+  mgr->node = node;
+  mgr->size = size;
+  mgr->num = 0;
+  mgr->mode = mode;
+  mgr->cb = cb;
+  mgr->arg = arg;
 
-  *val = reg.empty_fifo;
+  for (i = 0; i < LPS25HB_MGR_BUS_MAX; i++)
+  {
+    mgr->next[i] = 0;
+    mgr->busy[i] = 0;
+  }
 
-  return ret;
+  mgr->bus_next = 0;
 }
 
 /**
-  * @brief  FIFO overrun status flag.[get]
+  * @brief  Register a sensor. Its stream consumer is set by the manager.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of ovr in reg FIFO_STATUS.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  mgr      Manager.(ptr)
+  * @param  ctx      Sensor interface.(ptr)
+  * @param  stream   Sensor FIFO stream, ts may be set.(ptr)
+  * @param  bus      Bus index, lower than LPS25HB_MGR_BUS_MAX
+  * @retval          Sensor id, -1 if the table is full or bus is invalid
   *
   */
-int32_t lps25hb_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lps25hb_mgr_add(lps25hb_mgr_t *mgr, const stmdev_ctx_t *ctx,
+                        lps25hb_fifo_stream_t *stream, uint8_t bus)
 {
-  lps25hb_fifo_status_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
+  lps25hb_mgr_node_t *node;
 
-  *val = reg.ovr;
+  if ((mgr->num >= mgr->size) || (bus >= LPS25HB_MGR_BUS_MAX))
+  {
+    return -1;
+  }
 
-  return ret;
+  node = &mgr->node[mgr->num];
+  node->ctx = ctx;
+  node->stream = stream;
+  node->mgr = mgr;
+  node->id = mgr->num;
+  node->bus = bus;
+  node->present = 0;
+  node->pending = 0;
+  stream->cb = lps25hb_mgr_stream_cb;
+  stream->arg = node;
+  mgr->num++;
+
+  return (int32_t)node->id;
 }
 
 /**
-  * @brief  FIFO watermark status.[get]
+  * @brief  Check the WHO_AM_I of all the registered sensors. Sensors not
+  *         answering LPS25HB_ID are skipped afterwards.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of fth_fifo in reg FIFO_STATUS.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  mgr    Manager.(ptr)
+  * @retval        Number of sensors found
   *
   */
-int32_t lps25hb_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
+uint16_t lps25hb_mgr_probe(lps25hb_mgr_t *mgr)
 {
-  lps25hb_fifo_status_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_FIFO_STATUS, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
+  uint16_t found = 0;
+  uint8_t whoami;
+  uint16_t i;
 
-  *val = reg.fth_fifo;
+  for (i = 0; i < mgr->num; i++)
+  {
+    mgr->node[i].present = 0;
+
+    if ((lps25hb_device_id_get(mgr->node[i].ctx, &whoami) == 0) &&
+        (whoami == LPS25HB_ID))
+    {
+      mgr->node[i].present = 1;
+      found++;
+    }
+  }
 
-  return ret;
+  return found;
 }
 
 /**
-  * @}
+  * @brief  Start the FIFO stream of all the sensors found. A sensor
+  *         that fails to start does not stop the others.
   *
-  */
-
-/**
-  * @defgroup   LPS25HB_serial_interface
-  * @brief      This section group all the functions concerning serial
-  *             interface management
-  * @{
+  * @param  mgr    Manager.(ptr)
+  * @param  wtm    FIFO watermark level (see lps25hb_fifo_watermark_set)
+  * @retval        Status of the first sensor that failed
+  *                (MANDATORY: return 0 -> no Error).
   *
   */
+int32_t lps25hb_mgr_start(lps25hb_mgr_t *mgr, uint8_t wtm)
+{
+  int32_t ret = 0;
+  int32_t err;
+  uint16_t i;
+
+  for (i = 0; i < mgr->num; i++)
+  {
+    if (mgr->node[i].present != 0U)
+    {
+      err = lps25hb_fifo_stream_start(mgr->node[i].ctx, wtm);
+
+      if (ret == 0)
+      {
+        ret = err;
+      }
+    }
+  }
+
+  return ret;
+}
 
 /**
-  * @brief  SPI Serial Interface Mode selection.[set]
+  * @brief  Request the drain of a sensor. To be called on its FIFO
+  *         watermark interrupt, in LPS25HB_MGR_IRQ mode.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of sim in reg CTRL_REG1
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  mgr    Manager.(ptr)
+  * @param  id     Sensor id
   *
   */
-int32_t lps25hb_spi_mode_set(const stmdev_ctx_t *ctx, lps25hb_sim_t val)
+void lps25hb_mgr_notify(lps25hb_mgr_t *mgr, uint16_t id)
 {
-  lps25hb_ctrl_reg1_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
-
-  if (ret == 0)
+  if (id < mgr->num)
   {
-    reg.sim = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
+    mgr->node[id].pending = 1;
   }
-
-  return ret;
 }
 
 /**
-  * @brief  SPI Serial Interface Mode selection.[get]
+  * @brief  Drain the next sensor of a bus, in round-robin: the next one
+  *         with a pending request in LPS25HB_MGR_IRQ mode, the next one
+  *         found in LPS25HB_MGR_POLL mode.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of sim in reg CTRL_REG1.(ptr)
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  mgr    Manager.(ptr)
+  * @param  bus    Bus index
+  * @param  now    Host time of the drain [us]
+  * @retval        Interface status (MANDATORY: return 0 -> no Error),
+  *                nothing done if no sensor is ready.
   *
   */
-int32_t lps25hb_spi_mode_get(const stmdev_ctx_t *ctx, lps25hb_sim_t *val)
+int32_t lps25hb_mgr_service(lps25hb_mgr_t *mgr, uint8_t bus, uint32_t now)
 {
-  lps25hb_ctrl_reg1_t reg;
-  int32_t ret;
+  lps25hb_mgr_node_t *node;
+  uint16_t idx;
+  uint16_t i;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG1, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  switch (reg.sim)
+  if ((bus >= LPS25HB_MGR_BUS_MAX) || (mgr->num == 0U))
   {
-    case LPS25HB_SPI_4_WIRE:
-      *val = LPS25HB_SPI_4_WIRE;
-      break;
+    return 0;
+  }
 
-    case LPS25HB_SPI_3_WIRE:
-      *val = LPS25HB_SPI_3_WIRE;
-      break;
+  idx = mgr->next[bus];
 
-    default:
-      *val = LPS25HB_SPI_4_WIRE;
-      break;
+  for (i = 0; i < mgr->num; i++)
+  {
+    idx = (idx >= mgr->num) ? 0U : idx;
+    node = &mgr->node[idx];
+    idx++;
+
+    if ((node->bus == bus) && (node->present != 0U) &&
+        ((mgr->mode == LPS25HB_MGR_POLL) || (node->pending != 0U)))
+    {
+      mgr->next[bus] = idx;
+      node->pending = 0;
+
+      return lps25hb_fifo_stream_drain(node->ctx, node->stream, now);
+    }
   }
 
-  return ret;
+  return 0;
 }
 
 /**
-  * @brief  Disable I2C interface.[set]
+  * @brief  Check if a bus has a sensor to drain.
   *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Change the values of i2c_dis in reg CTRL_REG2
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  mgr    Manager.(ptr)
+  * @param  bus    Bus index
+  * @retval        1 if lps25hb_mgr_service has work on the bus, 0 otherwise
   *
   */
-int32_t lps25hb_i2c_interface_set(const stmdev_ctx_t *ctx,
-                                  lps25hb_i2c_dis_t val)
+static uint8_t lps25hb_mgr_ready(const lps25hb_mgr_t *mgr, uint8_t bus)
 {
-  lps25hb_ctrl_reg2_t reg;
-  int32_t ret;
-
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+  const lps25hb_mgr_node_t *node;
+  uint16_t i;
 
-  if (ret == 0)
+  for (i = 0; i < mgr->num; i++)
   {
-    reg.i2c_dis = (uint8_t)val;
-    ret = lps25hb_write_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
+    node = &mgr->node[i];
+
+    if ((node->bus == bus) && (node->present != 0U) &&
+        ((mgr->mode == LPS25HB_MGR_POLL) || (node->pending != 0U)))
+    {
+      return 1;
+    }
   }
 
-  return ret;
+  return 0;
 }
 
 /**
-  * @brief  Disable I2C interface.[get]
-  *
-  * @param  ctx    Read / write interface definitions.(ptr)
-  * @param  val    Get the values of i2c_dis in reg CTRL_REG2.(ptr)
+  * @brief  Drain the next sensor of any ready bus not served by another
+  *         worker. Workers start from different buses, so that they
+  *         spread on the buses; each bus is served by one worker at a
+  *         time, which keeps the order of its transfers. Workers on
+  *         different buses call the manager consumer at the same time.
+  *
+  * @param  mgr    Manager.(ptr)
+  * @param  now    Host time of the drain [us]
+  * @param  bus    Bus served, LPS25HB_MGR_BUS_MAX if none was ready.(ptr)
   * @retval        Interface status (MANDATORY: return 0 -> no Error).
   *
   */
-int32_t lps25hb_i2c_interface_get(const stmdev_ctx_t *ctx,
-                                  lps25hb_i2c_dis_t *val)
+int32_t lps25hb_mgr_service_any(lps25hb_mgr_t *mgr, uint32_t now,
+                                uint8_t *bus)
 {
-  lps25hb_ctrl_reg2_t reg;
+  uint8_t first = mgr->bus_next;
+  uint8_t idx;
+  uint8_t i;
   int32_t ret;
 
-  ret = lps25hb_read_reg(ctx, LPS25HB_CTRL_REG2, (uint8_t *)&reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  switch (reg.i2c_dis)
+  for (i = 0; i < LPS25HB_MGR_BUS_MAX; i++)
   {
-    case LPS25HB_I2C_ENABLE:
-      *val = LPS25HB_I2C_ENABLE;
-      break;
-
-    case LPS25HB_I2C_DISABLE:
-      *val = LPS25HB_I2C_DISABLE;
-      break;
-
-    default:
-      *val = LPS25HB_I2C_ENABLE;
-      break;
+    idx = (uint8_t)((first + i) % LPS25HB_MGR_BUS_MAX);
+
+    if ((lps25hb_mgr_ready(mgr, idx) != 0U) &&
+        LPS25HB_MGR_CLAIM(mgr->busy[idx]))
+    {
+      mgr->bus_next = (uint8_t)((idx + 1U) % LPS25HB_MGR_BUS_MAX);
+      ret = lps25hb_mgr_service(mgr, idx, now);
+      LPS25HB_MGR_RELEASE(mgr->busy[idx]);
+      *bus = idx;
+
+      return ret;
+    }
   }
 
-  return ret;
+  *bus = (uint8_t)LPS25HB_MGR_BUS_MAX;
+
+  return 0;
 }
 
 /**
@@ -393,6 +393,138 @@ typedef union
   uint8_t                       byte;
 } lps25hb_reg_t;
 
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup LPS25HB_Private_Data
+  * @brief    Optional driver state referenced by stmdev_ctx_t::priv_data.
+  *           Leave priv_data NULL to keep the default behaviour, or point
+  *           it to a zero-initialized lps25hb_priv_t to enable the
+  *           features below.
+  *
+  *           The register shadow keeps a copy of the writable control
+  *           registers (REF_P, RES_CONF, CTRL_REG1..4, INTERRUPT_CFG,
+  *           FIFO_CTRL, THS_P, RPDS) so that the *_set functions only
+  *           read a register from the bus the first time it is modified.
+  *
+  *           The bus type lets the driver set the register address
+  *           auto-increment bit on multi-byte accesses (MSB of the I2C
+  *           sub-address, MS bit 6 of the SPI address byte). With
+  *           LPS25HB_BUS_PLATFORM the bit is left to the platform routines.
+  *
+  *           The optional read_multi / write_multi routines perform a list
+  *           of register segments as a single bus transaction (one start /
+  *           stop sequence). When not set, each segment is done on its own
+  *           through read_reg / write_reg.
+  *
+  *           The optional read_async routine starts a read and returns
+  *           immediately, calling back the driver when the transfer is
+  *           over. It is used by the *_async functions; when not set they
+  *           complete synchronously through read_reg.
+  *
+  *           When LPS25HB_INSTRUMENTATION is defined, lps25hb_read_reg /
+  *           lps25hb_write_reg also keep per register counters, errors
+  *           and a latency histogram (if get_tick is set), read back with
+  *           lps25hb_stats_get. Nothing is added otherwise.
+  *
+  * @{
+  *
+  */
+
+#define LPS25HB_SHADOW_FIRST    LPS25HB_REF_P_XL
+#define LPS25HB_SHADOW_LAST     LPS25HB_RPDS_H
+#define LPS25HB_SHADOW_SIZE \
+  (LPS25HB_SHADOW_LAST - LPS25HB_SHADOW_FIRST + 1U)
+
+typedef struct
+{
+  uint8_t  reg[LPS25HB_SHADOW_SIZE];
+  uint64_t valid; /* one bit per address, from LPS25HB_SHADOW_FIRST */
+} lps25hb_shadow_t;
+
+typedef enum
+{
+  LPS25HB_BUS_PLATFORM = 0,
+  LPS25HB_BUS_I2C      = 1,
+  LPS25HB_BUS_SPI      = 2,
+} lps25hb_bus_t;
+
+#ifdef LPS25HB_INSTRUMENTATION
+
+/** Per register statistics, multi-segment and async transfers included;
+  * latency bucket 0 counts [0, 2) ticks, bucket n counts [2^n, 2^(n+1))
+  * ticks and the last one every latency above **/
+#define LPS25HB_STATS_REG_NUM   0x40U
+#define LPS25HB_STATS_BUCKETS   16U
+
+typedef struct
+{
+  uint32_t read_cnt;
+  uint32_t write_cnt;
+  uint32_t bytes;
+  uint32_t err_cnt;
+  int32_t  last_err;
+  uint32_t latency[LPS25HB_STATS_BUCKETS];
+} lps25hb_reg_stats_t;
+
+typedef uint32_t (*lps25hb_tick_ptr)(void);
+
+typedef struct
+{
+  volatile uint32_t   begin; /* updates started */
+  volatile uint32_t   end;   /* updates completed */
+  lps25hb_reg_stats_t reg[LPS25HB_STATS_REG_NUM];
+} lps25hb_stats_t;
+
+#endif /* LPS25HB_INSTRUMENTATION */
+
+/** Register segment of a multi-segment transaction **/
+typedef struct
+{
+  uint8_t  reg;
+  uint8_t *data;
+  uint16_t len;
+} lps25hb_seg_t;
+
+typedef int32_t (*lps25hb_multi_ptr)(void *, lps25hb_seg_t *, uint16_t);
+
+/** Completion of a transfer: (arg, interface status) **/
+typedef void (*lps25hb_done_ptr)(void *, int32_t);
+/** Start a read and return; done(arg, status) is called on completion **/
+typedef int32_t (*lps25hb_read_async_ptr)(void *, uint8_t, uint8_t *,
+                                          uint16_t, lps25hb_done_ptr,
+                                          void *);
+
+/** Lock / unlock of the sensor (arg), must allow nesting (recursive) **/
+typedef void (*lps25hb_lock_ptr)(void *);
+
+typedef struct
+{
+  /** Register shadow, used only when shadow_en is set **/
+  lps25hb_shadow_t  shadow;
+  uint8_t           shadow_en;
+  lps25hb_bus_t     bus;
+  /** Optional lock held across read-modify-write and multi-register
+    * operations only: data reads and async transfers run without it,
+    * so bus routines shared by several contexts must be bus-safe **/
+  lps25hb_lock_ptr  lock;
+  lps25hb_lock_ptr  unlock;
+  void             *lock_arg;
+  /** Optional multi-segment transaction routines (e.g. I2C_RDWR) **/
+  lps25hb_multi_ptr read_multi;
+  lps25hb_multi_ptr write_multi;
+  /** Optional non-blocking read routine (e.g. DMA based) **/
+  lps25hb_read_async_ptr read_async;
+#ifdef LPS25HB_INSTRUMENTATION
+  /** Optional time base for latency, in any unit (e.g. us) **/
+  lps25hb_tick_ptr  get_tick;
+  lps25hb_stats_t   stats;
+#endif /* LPS25HB_INSTRUMENTATION */
+} lps25hb_priv_t;
+
 /**
   * @}
   *
@@ -418,10 +550,36 @@ int32_t lps25hb_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
                           uint8_t *data,
                           uint16_t len);
 
+#ifdef LPS25HB_INSTRUMENTATION
+int32_t lps25hb_stats_get(const stmdev_ctx_t *ctx, uint8_t reg,
+                          lps25hb_reg_stats_t *val);
+#endif /* LPS25HB_INSTRUMENTATION */
+
+int32_t lps25hb_read_multi_reg(const stmdev_ctx_t *ctx, lps25hb_seg_t *seg,
+                               uint16_t num);
+int32_t lps25hb_write_multi_reg(const stmdev_ctx_t *ctx, lps25hb_seg_t *seg,
+                                uint16_t num);
+
+int32_t lps25hb_shadow_invalidate(const stmdev_ctx_t *ctx);
+
 float_t lps25hb_from_lsb_to_hpa(uint32_t lsb);
 
 float_t lps25hb_from_lsb_to_degc(int16_t lsb);
 
+void lps25hb_from_lsb_to_hpa_batch(const uint32_t *lsb, float_t *hpa,
+                                   uint32_t num);
+void lps25hb_from_lsb_to_degc_batch(const int16_t *lsb, float_t *degc,
+                                    uint32_t num);
+void lps25hb_from_raw_to_units(const uint8_t *raw, float_t *hpa,
+                               float_t *degc, uint32_t num);
+
+uint32_t lps25hb_from_lsb_to_pa(uint32_t lsb);
+int16_t lps25hb_from_lsb_to_cdegc(int16_t lsb);
+void lps25hb_from_lsb_to_pa_batch(const uint32_t *lsb, uint32_t *pa,
+                                  uint32_t num);
+void lps25hb_from_lsb_to_cdegc_batch(const int16_t *lsb, int16_t *cdegc,
+                                     uint32_t num);
+
 int32_t lps25hb_pressure_ref_set(const stmdev_ctx_t *ctx, int32_t val);
 int32_t lps25hb_pressure_ref_get(const stmdev_ctx_t *ctx, int32_t *val);
 
@@ -492,6 +650,14 @@ int32_t lps25hb_pressure_raw_get(const stmdev_ctx_t *ctx, uint32_t *buff);
 
 int32_t lps25hb_temperature_raw_get(const stmdev_ctx_t *ctx, int16_t *buff);
 
+typedef struct
+{
+  lps25hb_status_reg_t status;
+  uint32_t             pressure;    /* as lps25hb_pressure_raw_get */
+  int16_t              temperature; /* as lps25hb_temperature_raw_get */
+} lps25hb_data_t;
+int32_t lps25hb_data_get(const stmdev_ctx_t *ctx, lps25hb_data_t *val);
+
 int32_t lps25hb_pressure_offset_set(const stmdev_ctx_t *ctx, int16_t val);
 int32_t lps25hb_pressure_offset_get(const stmdev_ctx_t *ctx, int16_t *val);
 
@@ -506,6 +672,17 @@ int32_t lps25hb_boot_get(const stmdev_ctx_t *ctx, uint8_t *val);
 int32_t lps25hb_status_get(const stmdev_ctx_t *ctx,
                            lps25hb_status_reg_t *val);
 
+typedef struct
+{
+  lps25hb_int_source_t  int_source;
+  lps25hb_status_reg_t  status_reg;
+  lps25hb_fifo_status_t fifo_status;
+} lps25hb_all_sources_t;
+int32_t lps25hb_all_sources_get(const stmdev_ctx_t *ctx,
+                                lps25hb_all_sources_t *val);
+
+int32_t lps25hb_int_pending_get(const stmdev_ctx_t *ctx, uint8_t *val);
+
 int32_t lps25hb_int_generation_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lps25hb_int_generation_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
@@ -626,6 +803,19 @@ int32_t lps25hb_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lps25hb_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
+typedef struct
+{
+  uint32_t pressure;    /* same format of lps25hb_pressure_raw_get */
+  int16_t  temperature; /* same format of lps25hb_temperature_raw_get */
+} lps25hb_fifo_sample_t;
+int32_t lps25hb_fifo_data_get(const stmdev_ctx_t *ctx,
+                              lps25hb_fifo_sample_t *val, uint8_t num);
+
+/** Bytes of a sample, from PRESS_OUT_XL (28h) to TEMP_OUT_H (2Ch) **/
+#define LPS25HB_SAMPLE_LEN      5U
+int32_t lps25hb_fifo_raw_get(const stmdev_ctx_t *ctx, uint8_t *buff,
+                             uint8_t num);
+
 typedef enum
 {
   LPS25HB_SPI_4_WIRE = 0,
@@ -644,6 +834,259 @@ int32_t lps25hb_i2c_interface_set(const stmdev_ctx_t *ctx,
 int32_t lps25hb_i2c_interface_get(const stmdev_ctx_t *ctx,
                                   lps25hb_i2c_dis_t *val);
 
+typedef struct
+{
+  lps25hb_odr_t       odr;
+  uint8_t             bdu;
+  lps25hb_avgp_t      pressure_avg;
+  lps25hb_avgt_t      temperature_avg;
+  lps25hb_sim_t       spi_mode;
+  lps25hb_i2c_dis_t   i2c_interface;
+  uint8_t             fifo_en;
+  uint8_t             fifo_mean_dec;
+  uint8_t             stop_on_fth;
+  lps25hb_f_mode_t    fifo_mode;
+  uint8_t             fifo_watermark;
+  uint8_t             int_generation;
+  lps25hb_int_s_t     int_pin_mode;
+  lps25hb_pp_od_t     pin_mode;
+  lps25hb_int_h_l_t   int_polarity;
+  uint8_t             drdy_on_int;
+  uint8_t             fifo_ovr_on_int;
+  uint8_t             fifo_threshold_on_int;
+  uint8_t             fifo_empty_on_int;
+  lps25hb_pe_t        sign_of_int_threshold;
+  lps25hb_lir_t       int_notification_mode;
+  uint16_t            int_threshold;
+  int16_t             pressure_offset;
+} lps25hb_cfg_t;
+
+typedef enum
+{
+  LPS25HB_CFG_WRITE_ALL     = 0,
+  LPS25HB_CFG_WRITE_CHANGED = 1,
+} lps25hb_cfg_write_t;
+int32_t lps25hb_cfg_commit(const stmdev_ctx_t *ctx, const lps25hb_cfg_t *val,
+                           lps25hb_cfg_write_t mode);
+
+int32_t lps25hb_load_ucf(const stmdev_ctx_t *ctx, const ucf_line_t *val,
+                         uint16_t num, uint8_t verify);
+
+/** Asynchronous request, owned by the caller until done is called **/
+typedef struct
+{
+  lps25hb_done_ptr        done;   /* set by the caller */
+  void                   *arg;    /* set by the caller */
+  const stmdev_ctx_t     *ctx;
+  lps25hb_data_t         *data;
+  lps25hb_fifo_sample_t  *sample;
+  int32_t                 status; /* status of the last transfer */
+  volatile uint8_t        state;  /* submission state, driver internal */
+#ifdef LPS25HB_INSTRUMENTATION
+  uint32_t                start;  /* tick of the transfer start */
+#endif /* LPS25HB_INSTRUMENTATION */
+  uint8_t                 num;
+  uint8_t                 idx;
+  uint8_t                 buff[6];
+} lps25hb_async_t;
+int32_t lps25hb_data_get_async(const stmdev_ctx_t *ctx, lps25hb_async_t *req,
+                               lps25hb_data_t *val);
+int32_t lps25hb_fifo_data_get_async(const stmdev_ctx_t *ctx,
+                                    lps25hb_async_t *req,
+                                    lps25hb_fifo_sample_t *val, uint8_t num);
+
+#define LPS25HB_FIFO_SIZE       32U
+
+/** Gap marker: samples lost before the next one, pressure = lost count **/
+#define LPS25HB_SAMPLE_GAP      0x01U
+/** Samples were lost before this one (FIFO overrun, full buffer) **/
+#define LPS25HB_SAMPLE_AFTER_GAP  0x02U
+
+typedef struct
+{
+  uint32_t pressure;    /* as lps25hb_pressure_raw_get */
+  int16_t  temperature; /* as lps25hb_temperature_raw_get */
+  uint8_t  flags;       /* LPS25HB_SAMPLE_GAP */
+  uint32_t timestamp;   /* host time [us] */
+} lps25hb_sample_t;
+
+typedef struct
+{
+  float_t  period; /* nominal sample period [us] */
+  float_t  w;      /* regression weight */
+  float_t  mx;     /* mean sample index, relative to the last drain */
+  float_t  my;     /* mean time [us], relative to the last drain */
+  float_t  cxx;
+  float_t  cxy;
+  uint32_t last;   /* host time of the last drain [us] */
+} lps25hb_ts_t;
+int32_t lps25hb_ts_init(lps25hb_ts_t *val, lps25hb_odr_t odr);
+void lps25hb_ts_update(lps25hb_ts_t *val, uint32_t now,
+                       lps25hb_sample_t *sample, uint8_t num);
+void lps25hb_ts_skip(lps25hb_ts_t *val, uint32_t num);
+float_t lps25hb_ts_period_get(const lps25hb_ts_t *val);
+float_t lps25hb_ts_drift_get(const lps25hb_ts_t *val);
+
+/** Consumer of the samples drained from FIFO: (arg, samples, number) **/
+typedef void (*lps25hb_stream_ptr)(void *, const lps25hb_sample_t *,
+                                   uint8_t);
+typedef struct
+{
+  lps25hb_stream_ptr     cb;         /* set by the caller */
+  void                  *arg;        /* set by the caller */
+  lps25hb_ts_t          *ts;         /* optional, set by the caller */
+  uint32_t               count;      /* samples delivered to cb */
+  uint32_t               lost;       /* samples lost, estimated */
+  uint32_t               overrun;    /* drains that found an overrun */
+  uint32_t               last;       /* host time of the last drain [us] */
+  lps25hb_status_reg_t   status_reg; /* STATUS_REG of the last drain */
+  lps25hb_fifo_status_t  status;     /* FIFO_STATUS of the last drain */
+  lps25hb_sample_t       buff[LPS25HB_FIFO_SIZE + 1U];
+} lps25hb_fifo_stream_t;
+int32_t lps25hb_fifo_stream_start(const stmdev_ctx_t *ctx, uint8_t wtm);
+int32_t lps25hb_fifo_stream_stop(const stmdev_ctx_t *ctx);
+int32_t lps25hb_fifo_stream_drain(const stmdev_ctx_t *ctx,
+                                  lps25hb_fifo_stream_t *stream,
+                                  uint32_t now);
+
+#ifndef LPS25HB_CACHE_LINE
+#define LPS25HB_CACHE_LINE      64U
+#endif /* LPS25HB_CACHE_LINE */
+
+#ifndef LPS25HB_CACHE_ALIGNED
+#if defined(__GNUC__)
+#define LPS25HB_CACHE_ALIGNED   __attribute__((aligned(LPS25HB_CACHE_LINE)))
+#else
+#define LPS25HB_CACHE_ALIGNED
+#endif /* __GNUC__ */
+#endif /* LPS25HB_CACHE_ALIGNED */
+
+/*
+ * Single-producer / single-consumer ring, size must be a power of 2.
+ * The read-only, producer and consumer fields each fill one cache line;
+ * the ring must be aligned to LPS25HB_CACHE_LINE (LPS25HB_CACHE_ALIGNED
+ * does it on GCC and compatible compilers, a heap allocated ring needs
+ * an aligned allocation).
+ */
+typedef struct
+{
+  lps25hb_sample_t *buff;    /* set by lps25hb_ring_init only */
+  uint32_t          mask;    /* set by lps25hb_ring_init only */
+  uint8_t           pad_ro[LPS25HB_CACHE_LINE - sizeof(lps25hb_sample_t *) -
+                           sizeof(uint32_t)];
+  volatile uint32_t head;    /* written by the producer only */
+  volatile uint32_t dropped; /* entries not fitting, producer side */
+  uint8_t           gap;     /* flag the next entry pushed, producer side */
+  uint8_t           pad_head[LPS25HB_CACHE_LINE - (2U * sizeof(uint32_t)) -
+                             sizeof(uint8_t)];
+  volatile uint32_t tail; /* written by the consumer only */
+  uint8_t           pad_tail[LPS25HB_CACHE_LINE - sizeof(uint32_t)];
+} LPS25HB_CACHE_ALIGNED lps25hb_ring_t;
+int32_t lps25hb_ring_init(lps25hb_ring_t *ring, lps25hb_sample_t *buff,
+                          uint32_t size);
+uint32_t lps25hb_ring_push(lps25hb_ring_t *ring, const lps25hb_sample_t *val,
+                           uint32_t num);
+uint32_t lps25hb_ring_pop(lps25hb_ring_t *ring, lps25hb_sample_t *val,
+                          uint32_t num);
+void lps25hb_ring_stream_cb(void *ring, const lps25hb_sample_t *val,
+                            uint8_t num);
+
+typedef struct
+{
+  uint32_t latency_ms; /* latency budget, set by the caller */
+  uint8_t  level;      /* FIFO watermark level in use, in samples */
+  uint8_t  margin;     /* extra free slots added after overruns */
+  uint8_t  clean;      /* updates without overrun since last margin change */
+  uint32_t overrun;    /* overrun events seen */
+} lps25hb_fifo_wtm_ctrl_t;
+int32_t lps25hb_fifo_wtm_ctrl_update(const stmdev_ctx_t *ctx,
+                                     lps25hb_fifo_wtm_ctrl_t *val,
+                                     const lps25hb_fifo_status_t *status,
+                                     uint32_t drain_ms);
+
+/** Structure-of-arrays sample buffer on caller-provided arrays **/
+typedef struct
+{
+  uint32_t *pressure;    /* as lps25hb_pressure_raw_get */
+  int16_t  *temperature; /* as lps25hb_temperature_raw_get */
+  uint32_t *timestamp;   /* host time [us], optional */
+  uint8_t  *flags;       /* LPS25HB_SAMPLE_AFTER_GAP, optional */
+  uint32_t  size;        /* capacity, in samples */
+  uint32_t  len;         /* samples stored */
+  uint32_t  dropped;     /* samples not fitting, lps25hb_soa_stream_cb */
+  uint8_t   gap;         /* flag the next sample stored */
+  uint32_t  count;       /* samples read, lps25hb_soa_fifo_fill */
+  uint32_t  lost;        /* samples lost in FIFO overrun, estimated */
+  uint32_t  overrun;     /* FIFO overrun events, lps25hb_soa_fifo_fill */
+  uint32_t  last;        /* host time of the last read [us] */
+} lps25hb_soa_t;
+int32_t lps25hb_soa_init(lps25hb_soa_t *buf, uint32_t *pressure,
+                         int16_t *temperature, uint32_t *timestamp,
+                         uint8_t *flags, uint32_t size);
+void lps25hb_soa_clear(lps25hb_soa_t *buf);
+void lps25hb_soa_discard(lps25hb_soa_t *buf, uint32_t num);
+uint32_t lps25hb_soa_append(lps25hb_soa_t *buf, const lps25hb_sample_t *val,
+                            uint32_t num);
+void lps25hb_soa_stream_cb(void *buf, const lps25hb_sample_t *val,
+                           uint8_t num);
+int32_t lps25hb_soa_fifo_fill(const stmdev_ctx_t *ctx, lps25hb_soa_t *buf,
+                              uint32_t now);
+
+#ifndef LPS25HB_MGR_BUS_MAX
+#define LPS25HB_MGR_BUS_MAX     8U
+#endif /* LPS25HB_MGR_BUS_MAX */
+
+/* bus indexes are uint8_t, LPS25HB_MGR_BUS_MAX itself means no bus */
+#if (LPS25HB_MGR_BUS_MAX < 1) || (LPS25HB_MGR_BUS_MAX > 255)
+#error "LPS25HB_MGR_BUS_MAX must be in the range 1 to 255"
+#endif /* LPS25HB_MGR_BUS_MAX */
+
+typedef void (*lps25hb_mgr_ptr)(void *arg, uint16_t id,
+                                const lps25hb_sample_t *val, uint8_t num);
+
+typedef enum
+{
+  LPS25HB_MGR_IRQ  = 0, /* drain sensors flagged by lps25hb_mgr_notify */
+  LPS25HB_MGR_POLL = 1, /* drain all the sensors in turn */
+} lps25hb_mgr_mode_t;
+
+struct lps25hb_mgr_s;
+
+typedef struct
+{
+  const stmdev_ctx_t    *ctx;     /* sensor interface */
+  lps25hb_fifo_stream_t *stream;  /* sensor FIFO stream */
+  struct lps25hb_mgr_s  *mgr;     /* owner */
+  uint16_t               id;      /* sensor id, index in the manager */
+  uint8_t                bus;     /* bus index */
+  uint8_t                present; /* device found by lps25hb_mgr_probe */
+  volatile uint8_t       pending; /* drain requested */
+} lps25hb_mgr_node_t;
+
+typedef struct lps25hb_mgr_s
+{
+  lps25hb_mgr_node_t *node;  /* set by lps25hb_mgr_init */
+  uint16_t            size;
+  uint16_t            num;
+  lps25hb_mgr_mode_t  mode;
+  lps25hb_mgr_ptr     cb;    /* reentrant, see lps25hb_mgr_init */
+  void               *arg;
+  uint16_t            next[LPS25HB_MGR_BUS_MAX]; /* round-robin cursors */
+  volatile uint8_t    busy[LPS25HB_MGR_BUS_MAX]; /* bus claimed */
+  volatile uint8_t    bus_next; /* first bus tried by service_any */
+} lps25hb_mgr_t;
+void lps25hb_mgr_init(lps25hb_mgr_t *mgr, lps25hb_mgr_node_t *node,
+                      uint16_t size, lps25hb_mgr_mode_t mode,
+                      lps25hb_mgr_ptr cb, void *arg);
+int32_t lps25hb_mgr_add(lps25hb_mgr_t *mgr, const stmdev_ctx_t *ctx,
+                        lps25hb_fifo_stream_t *stream, uint8_t bus);
+uint16_t lps25hb_mgr_probe(lps25hb_mgr_t *mgr);
+int32_t lps25hb_mgr_start(lps25hb_mgr_t *mgr, uint8_t wtm);
+void lps25hb_mgr_notify(lps25hb_mgr_t *mgr, uint16_t id);
+int32_t lps25hb_mgr_service(lps25hb_mgr_t *mgr, uint8_t bus, uint32_t now);
+int32_t lps25hb_mgr_service_any(lps25hb_mgr_t *mgr, uint32_t now,
+                                uint8_t *bus);
+
 /**
   *@}
   *